@@ -1,5 +1,6 @@
 #include "Config.hpp"
 
+#include <algorithm>
 #include <exception>
 #include <fstream>
 #include <string>
@@ -86,6 +87,11 @@ void Config::fromJson(const nlohmann::json& j)
     {
         const auto& graphics_config = j["graphics"];
         vsync_enabled_ = graphics_config.value("vsync", vsync_enabled_);
+        sprite_batching_ = graphics_config.value("sprite_batching", sprite_batching_);
+        deferred_rendering_ = graphics_config.value("deferred_rendering", deferred_rendering_);
+        texture_atlas_enabled_ = graphics_config.value("texture_atlas", texture_atlas_enabled_);
+        texture_atlas_page_size_ = graphics_config.value("texture_atlas_page_size", texture_atlas_page_size_);
+        ui_cache_enabled_ = graphics_config.value("ui_cache", ui_cache_enabled_);
     }
 
     if (j.contains("performance"))
@@ -97,6 +103,30 @@ void Config::fromJson(const nlohmann::json& j)
             spdlog::warn("Config target_fps is negative, resetting to 0 (no limit)");
             target_fps_ = 0;
         }
+        tick_rate_ = std::max(0, perf_config.value("tick_rate", tick_rate_));
+        max_ticks_per_frame_ = std::max(1, perf_config.value("max_ticks_per_frame", max_ticks_per_frame_));
+        pipelined_simulation_ = perf_config.value("pipelined_simulation", pipelined_simulation_);
+        frame_pacing_ = perf_config.value("frame_pacing", frame_pacing_);
+        spin_margin_us_ = std::max(0, perf_config.value("spin_margin_us", spin_margin_us_));
+        profiler_enabled_ = perf_config.value("profiler", profiler_enabled_);
+    }
+
+    if (j.contains("benchmark"))
+    {
+        const auto& benchmark_config = j["benchmark"];
+        headless_ = benchmark_config.value("headless", headless_);
+        benchmark_frames_ = std::max(0, benchmark_config.value("frames", benchmark_frames_));
+        benchmark_warmup_frames_ = std::max(0, benchmark_config.value("warmup_frames", benchmark_warmup_frames_));
+    }
+
+    if (j.contains("resources"))
+    {
+        const auto& resources_config = j["resources"];
+        async_texture_loading_ = resources_config.value("async_texture_loading", async_texture_loading_);
+        texture_upload_budget_ms_ = std::max(0.0f, resources_config.value("texture_upload_budget_ms", texture_upload_budget_ms_));
+        texture_upload_budget_kb_ = std::max(0, resources_config.value("texture_upload_budget_kb", texture_upload_budget_kb_));
+        texture_memory_budget_mb_ = std::max(0, resources_config.value("texture_memory_budget_mb", texture_memory_budget_mb_));
+        asset_archive_ = resources_config.value("archive", asset_archive_);
     }
 
     if (j.contains("audio"))
@@ -104,6 +134,7 @@ void Config::fromJson(const nlohmann::json& j)
         const auto& audio_config = j["audio"];
         music_volume_ = audio_config.value("music_volume", music_volume_);
         sound_volume_ = audio_config.value("sound_volume", sound_volume_);
+        sound_cache_dir_ = audio_config.value("pcm_cache_dir", sound_cache_dir_);
     }
 
     if (j.contains("input_mappings") && j["input_mappings"].is_object())
@@ -142,12 +173,41 @@ nlohmann::ordered_json Config::toJson() const
             "graphics",
             {
                 {"vsync", vsync_enabled_},
+                {"sprite_batching", sprite_batching_},
+                {"deferred_rendering", deferred_rendering_},
+                {"texture_atlas", texture_atlas_enabled_},
+                {"texture_atlas_page_size", texture_atlas_page_size_},
+                {"ui_cache", ui_cache_enabled_},
             },
         },
         {
             "performance",
             {
                 {"target_fps", target_fps_},
+                {"tick_rate", tick_rate_},
+                {"max_ticks_per_frame", max_ticks_per_frame_},
+                {"pipelined_simulation", pipelined_simulation_},
+                {"frame_pacing", frame_pacing_},
+                {"spin_margin_us", spin_margin_us_},
+                {"profiler", profiler_enabled_},
+            },
+        },
+        {
+            "benchmark",
+            {
+                {"headless", headless_},
+                {"frames", benchmark_frames_},
+                {"warmup_frames", benchmark_warmup_frames_},
+            },
+        },
+        {
+            "resources",
+            {
+                {"async_texture_loading", async_texture_loading_},
+                {"texture_upload_budget_ms", texture_upload_budget_ms_},
+                {"texture_upload_budget_kb", texture_upload_budget_kb_},
+                {"texture_memory_budget_mb", texture_memory_budget_mb_},
+                {"archive", asset_archive_},
             },
         },
         {
@@ -155,6 +215,7 @@ nlohmann::ordered_json Config::toJson() const
             {
                 {"music_volume", music_volume_},
                 {"sound_volume", sound_volume_},
+                {"pcm_cache_dir", sound_cache_dir_},
             },
         },
         {"input_mappings", input_mappings_},
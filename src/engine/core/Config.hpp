@@ -19,10 +19,43 @@ public:
     bool window_resizeable_ = true;
 
     bool vsync_enabled_ = true;
+    bool sprite_batching_ = true;
+    bool deferred_rendering_ = false;
+    bool texture_atlas_enabled_ = false;
+    int texture_atlas_page_size_ = 1024;
+    // retained HUD layer, redrawn only when marked dirty
+    bool ui_cache_enabled_ = false;
     int target_fps_ = 60;
+    // simulation ticks per second (0 = one variable step per frame) and the cap on ticks run in one frame
+    int tick_rate_ = 60;
+    int max_ticks_per_frame_ = 5;
+    // simulate frame N+1 on a worker thread while the main thread renders frame N (one frame of extra latency)
+    bool pipelined_simulation_ = false;
+    // "hybrid" sleeps to spin_margin_us_ before the frame deadline and spins the rest, "sleep" only sleeps
+    std::string frame_pacing_ = "hybrid";
+    int spin_margin_us_ = 2000;
+    // scoped markers are recorded only while enabled, dump with the "dump_profile" action
+    bool profiler_enabled_ = false;
+
+    // headless runs use the offscreen video driver and a software renderer, for benchmarks without a display
+    bool headless_ = false;
+    // stop after this many measured frames and print frame stats, 0 runs until quit
+    int benchmark_frames_ = 0;
+    int benchmark_warmup_frames_ = 10;
+
+    // decode textures on worker threads and upload at most this much per frame
+    bool async_texture_loading_ = true;
+    float texture_upload_budget_ms_ = 2.0f;
+    int texture_upload_budget_kb_ = 4096;
+    // least recently used unpinned textures are evicted above this, 0 = unlimited
+    int texture_memory_budget_mb_ = 0;
+    // packed archive relative to the project root, loose files are used when it's missing or empty
+    std::string asset_archive_ = "assets.pak";
 
     float music_volume_ = 0.5f;
     float sound_volume_ = 0.5f;
+    // decoded sound effects cached as PCM, relative to the project root, empty disables
+    std::string sound_cache_dir_ = "cache/pcm";
 
     std::unordered_map<std::string, std::vector<std::string>> input_mappings_ = {
         {"move_left", {"A", "Left"}},
@@ -32,6 +65,7 @@ public:
         {"jump", {"K", "Space"}},
         {"attack", {"J", "MouseLeft"}},
         {"pause", {"P", "Escape"}},
+        {"dump_profile", {"F9"}},
     };
 
     explicit Config(const std::string& filepath);
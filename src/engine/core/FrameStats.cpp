@@ -0,0 +1,92 @@
+#include "FrameStats.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+#include <spdlog/spdlog.h>
+
+namespace engine::core
+{
+
+namespace
+{
+// nearest-rank percentile over an already sorted sample set
+double percentile(const std::vector<double>& sorted, double p)
+{
+    auto rank = static_cast<size_t>(std::ceil(p * static_cast<double>(sorted.size())));
+    return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+}
+} // namespace
+
+FrameStats::FrameStats(size_t expected_frames)
+{
+    for (auto& samples : samples_)
+    {
+        samples.reserve(expected_frames);
+    }
+}
+
+void FrameStats::record(FramePhase phase, Uint64 duration_ns)
+{
+    samples_[static_cast<size_t>(phase)].push_back(static_cast<double>(duration_ns) / 1'000'000.0);
+}
+
+PhaseSummary FrameStats::summarize(FramePhase phase) const
+{
+    PhaseSummary summary;
+    std::vector<double> sorted = samples_[static_cast<size_t>(phase)];
+    if (sorted.empty())
+        return summary;
+
+    std::sort(sorted.begin(), sorted.end());
+    summary.mean_ms = std::accumulate(sorted.begin(), sorted.end(), 0.0) / static_cast<double>(sorted.size());
+    summary.p50_ms = percentile(sorted, 0.50);
+    summary.p95_ms = percentile(sorted, 0.95);
+    summary.p99_ms = percentile(sorted, 0.99);
+    summary.max_ms = sorted.back();
+    return summary;
+}
+
+void FrameStats::clear()
+{
+    for (auto& samples : samples_)
+    {
+        samples.clear();
+    }
+}
+
+void FrameStats::logReport() const
+{
+    spdlog::info("Frame stats over {} frames (ms):", getFrameCount());
+    spdlog::info("{:<8} {:>8} {:>8} {:>8} {:>8} {:>8}", "phase", "mean", "p50", "p95", "p99", "max");
+    for (size_t i = 0; i < samples_.size(); ++i)
+    {
+        auto phase = static_cast<FramePhase>(i);
+        PhaseSummary summary = summarize(phase);
+        spdlog::info("{:<8} {:>8.3f} {:>8.3f} {:>8.3f} {:>8.3f} {:>8.3f}", getPhaseName(phase), summary.mean_ms, summary.p50_ms, summary.p95_ms, summary.p99_ms, summary.max_ms);
+    }
+}
+
+std::string_view FrameStats::getPhaseName(FramePhase phase)
+{
+    switch (phase)
+    {
+    case FramePhase::INPUT:
+        return "input";
+    case FramePhase::EVENTS:
+        return "events";
+    case FramePhase::UPDATE:
+        return "update";
+    case FramePhase::RENDER:
+        return "render";
+    case FramePhase::PRESENT:
+        return "present";
+    case FramePhase::FRAME:
+        return "frame";
+    default:
+        return "unknown";
+    }
+}
+
+} // namespace engine::core
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+#include <SDL3/SDL_stdinc.h>
+
+namespace engine::core
+{
+
+enum class FramePhase
+{
+    INPUT,
+    EVENTS,
+    UPDATE,
+    RENDER,
+    PRESENT,
+    FRAME,
+    COUNT,
+};
+
+struct PhaseSummary
+{
+    double mean_ms = 0.0;
+    double p50_ms = 0.0;
+    double p95_ms = 0.0;
+    double p99_ms = 0.0;
+    double max_ms = 0.0;
+};
+
+// collects per-phase frame times for benchmark runs and reports percentiles
+class FrameStats final
+{
+private:
+    std::array<std::vector<double>, static_cast<size_t>(FramePhase::COUNT)> samples_;
+
+public:
+    explicit FrameStats(size_t expected_frames = 0);
+
+    FrameStats(const FrameStats&) = delete;
+    FrameStats& operator=(const FrameStats&) = delete;
+    FrameStats(FrameStats&&) = delete;
+    FrameStats& operator=(FrameStats&&) = delete;
+
+    void record(FramePhase phase, Uint64 duration_ns);
+    PhaseSummary summarize(FramePhase phase) const;
+    size_t getFrameCount() const { return samples_[static_cast<size_t>(FramePhase::FRAME)].size(); }
+    void clear();
+
+    void logReport() const;
+
+    static std::string_view getPhaseName(FramePhase phase);
+};
+
+} // namespace engine::core
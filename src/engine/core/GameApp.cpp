@@ -1,6 +1,9 @@
 #include "GameApp.hpp"
 
+#include <charconv>
 #include <memory>
+#include <string>
+#include <string_view>
 #include <vector>
 
 #include <spdlog/spdlog.h>
@@ -11,11 +14,21 @@
 #include <SDL3/SDL_scancode.h>
 
 #include "engine/core/Config.hpp"
+#include "engine/core/FrameStats.hpp"
+#include "engine/core/Profiler.hpp"
+#include "engine/core/ThreadPool.hpp"
 #include "engine/core/Time.hpp"
 #include "engine/input/InputManager.hpp"
+#include "engine/level/BinaryLevel.hpp"
+#include "engine/level/CollisionGrid.hpp"
+#include "engine/level/LevelLoader.hpp"
 #include "engine/render/Camera.hpp"
 #include "engine/render/Renderer.hpp"
 #include "engine/render/Sprite.hpp"
+#include "engine/render/TextRenderer.hpp"
+#include "engine/render/TileGraphicTable.hpp"
+#include "engine/render/TileLayerRenderer.hpp"
+#include "engine/render/VisibilityIndex.hpp"
 #include "engine/resource/ResourceManager.hpp"
 
 namespace engine::core
@@ -35,6 +48,35 @@ GameApp::~GameApp()
     }
 }
 
+bool GameApp::parseCommandLine(int argc, char* argv[])
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string_view arg = argv[i];
+        if (arg == "--headless")
+        {
+            cli_headless_ = true;
+        }
+        else if (arg == "--frames" && i + 1 < argc)
+        {
+            std::string_view value = argv[++i];
+            auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(), cli_frames_);
+            if (ec != std::errc() || ptr != value.data() + value.size() || cli_frames_ < 0)
+            {
+                spdlog::error("Invalid --frames value: {}", value);
+                return false;
+            }
+        }
+        else
+        {
+            spdlog::error("Unknown command line argument: {}", arg);
+            spdlog::info("Usage: Island [--headless] [--frames <n>]");
+            return false;
+        }
+    }
+    return true;
+}
+
 void GameApp::run()
 {
     if (!init())
@@ -42,16 +84,79 @@ void GameApp::run()
 
     while (is_running_)
     {
+        ISLAND_PROFILE_SCOPE("GameApp::frame");
         time_->update();
         float delta_time = time_->getDeltaTime();
-        input_manager_->update();
 
-        handleEvent();
-        update(delta_time);
-        render();
+        Uint64 frame_start = SDL_GetTicksNS();
+        {
+            ISLAND_PROFILE_SCOPE("InputManager::update");
+            input_manager_->update();
+        }
+        Uint64 input_end = SDL_GetTicksNS();
+        {
+            ISLAND_PROFILE_SCOPE("GameApp::handleEvent");
+            handleEvent();
+        }
+        Uint64 events_end = SDL_GetTicksNS();
+        {
+            ISLAND_PROFILE_SCOPE("GameApp::update");
+            int ticks = 1;
+            float step = delta_time;
+            if (time_->isFixedStep())
+            {
+                ticks = time_->consumeFixedTicks();
+                step = time_->getFixedDeltaTime();
+            }
+            float alpha = time_->getInterpolationAlpha();
+
+            if (simulation_thread_)
+            {
+                // renders last frame's snapshot below while this runs
+                pending_simulation_ = simulation_thread_->submit([this, ticks, step, alpha]() { simulate(ticks, step, alpha); });
+            }
+            else
+            {
+                simulate(ticks, step, alpha);
+                publishSnapshot();
+            }
+        }
+        Uint64 update_end = SDL_GetTicksNS();
+        {
+            ISLAND_PROFILE_SCOPE("GameApp::render");
+            render();
+        }
+        Uint64 render_end = SDL_GetTicksNS();
+        {
+            ISLAND_PROFILE_SCOPE("Renderer::present");
+            renderer_->present();
+        }
+        Uint64 present_end = SDL_GetTicksNS();
+        if (pending_simulation_.valid())
+        {
+            ISLAND_PROFILE_SCOPE("GameApp::waitSimulation");
+            pending_simulation_.get();
+            publishSnapshot();
+        }
+        Uint64 frame_end = SDL_GetTicksNS();
+
+        if (frame_stats_)
+        {
+            recordFrame(frame_start, input_end, events_end, update_end, render_end, present_end, frame_end);
+        }
 
         // spdlog::trace("delta_time: {}", delta_time);
     }
+
+    time_->logPacingStats();
+    if (frame_stats_)
+    {
+        frame_stats_->logReport();
+        if (Profiler::isEnabled())
+        {
+            Profiler::dumpChromeTrace("island_profile.json");
+        }
+    }
     close();
 }
 
@@ -60,6 +165,7 @@ bool GameApp::init()
     spdlog::trace("Initializing GameApp...");
     if (!initConfig())
         return false;
+    Profiler::setEnabled(config_->profiler_enabled_);
     if (!initSDL())
         return false;
     if (!initTime())
@@ -72,9 +178,17 @@ bool GameApp::init()
         return false;
     if (!initInputManager())
         return false;
+    if (!initSimulationThread())
+        return false;
 
     testResourceManager();
 
+    if (config_->benchmark_frames_ > 0)
+    {
+        frame_stats_ = std::make_unique<FrameStats>(static_cast<size_t>(config_->benchmark_frames_));
+        spdlog::info("Benchmark: {} frames after {} warm-up frames", config_->benchmark_frames_, config_->benchmark_warmup_frames_);
+    }
+
     is_running_ = true;
     spdlog::info("Initialized GameApp");
     return true;
@@ -89,6 +203,22 @@ void GameApp::handleEvent()
         return;
     }
 
+    if (input_manager_->wereRenderTargetsReset())
+    {
+        spdlog::info("Render targets were reset, rebaking cached layers");
+        for (auto& tile_layer : tile_layers_)
+        {
+            if (tile_layer)
+                tile_layer->invalidate();
+        }
+        renderer_->markUIDirty();
+    }
+
+    if (input_manager_->isActionPressed("dump_profile"))
+    {
+        Profiler::dumpChromeTrace(fmt::format("island_profile_{}.json", SDL_GetTicks()));
+    }
+
     testInputManager();
 }
 
@@ -98,13 +228,61 @@ void GameApp::update(float delta_time)
     testCamera();
 }
 
+void GameApp::tick(float delta_time)
+{
+    previous_camera_position_ = camera_->getPosition();
+    update(delta_time);
+}
+
+void GameApp::simulate(int ticks, float delta_time, float alpha)
+{
+    ISLAND_PROFILE_SCOPE("GameApp::simulate");
+    for (int i = 0; i < ticks; ++i)
+    {
+        tick(delta_time);
+    }
+
+    RenderSnapshot& snapshot = snapshots_[1 - front_snapshot_];
+    snapshot.camera_position = camera_->getPosition();
+    snapshot.previous_camera_position = previous_camera_position_;
+    snapshot.alpha = alpha;
+}
+
+void GameApp::publishSnapshot()
+{
+    front_snapshot_ = 1 - front_snapshot_;
+}
+
 void GameApp::render()
 {
+    // uploads textures decoded since last frame, within the per-frame budget
+    resource_manager_->update();
+
+    const RenderSnapshot& snapshot = snapshots_[front_snapshot_];
+    render_camera_->setPosition(snapshot.previous_camera_position + (snapshot.camera_position - snapshot.previous_camera_position) * snapshot.alpha);
+
     renderer_->clearScreen();
 
     testRenderer();
+}
+
+void GameApp::recordFrame(Uint64 frame_start, Uint64 input_end, Uint64 events_end, Uint64 update_end, Uint64 render_end, Uint64 present_end, Uint64 frame_end)
+{
+    if (++frame_count_ <= config_->benchmark_warmup_frames_)
+        return;
+
+    // update is the main thread's share of the simulation: running it, or waiting for the pipelined one
+    frame_stats_->record(FramePhase::INPUT, input_end - frame_start);
+    frame_stats_->record(FramePhase::EVENTS, events_end - input_end);
+    frame_stats_->record(FramePhase::UPDATE, (update_end - events_end) + (frame_end - present_end));
+    frame_stats_->record(FramePhase::RENDER, render_end - update_end);
+    frame_stats_->record(FramePhase::PRESENT, present_end - render_end);
+    frame_stats_->record(FramePhase::FRAME, frame_end - frame_start);
 
-    renderer_->present();
+    if (frame_stats_->getFrameCount() >= static_cast<size_t>(config_->benchmark_frames_))
+    {
+        is_running_ = false;
+    }
 }
 
 void GameApp::close()
@@ -117,6 +295,13 @@ void GameApp::close()
 
     spdlog::trace("Closing GameApp...");
 
+    simulation_thread_.reset();
+
+    // text objects and cached targets belong to the SDL renderer
+    tile_layers_.clear();
+    text_renderer_.reset();
+    renderer_.reset();
+
     SDL_DestroyRenderer(sdl_renderer_);
     sdl_renderer_ = nullptr;
 
@@ -141,6 +326,22 @@ bool GameApp::initConfig()
         spdlog::error("Failed to initialize Config: {}", e.what());
         return false;
     }
+
+    if (cli_headless_)
+        config_->headless_ = true;
+    if (cli_frames_ >= 0)
+        config_->benchmark_frames_ = cli_frames_;
+
+    if (config_->headless_)
+    {
+        // nothing to sync to and nobody to close the window: unthrottled, CPU rasterizer, bounded run
+        config_->vsync_enabled_ = false;
+        config_->target_fps_ = 0;
+        if (config_->benchmark_frames_ == 0)
+        {
+            config_->benchmark_frames_ = 600;
+        }
+    }
     spdlog::info("Initialized Config");
     return true;
 }
@@ -148,7 +349,20 @@ bool GameApp::initConfig()
 bool GameApp::initSDL()
 {
     spdlog::trace("Initializing SDL...");
-    if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO) != true)
+    if (config_->headless_)
+    {
+        SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "offscreen");
+        SDL_SetHint(SDL_HINT_AUDIO_DRIVER, "dummy");
+    }
+    bool sdl_initialized = SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO);
+    if (!sdl_initialized && config_->headless_)
+    {
+        // SDL builds without the offscreen driver still have dummy
+        spdlog::warn("Offscreen video driver unavailable ({}), falling back to dummy", SDL_GetError());
+        SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "dummy");
+        sdl_initialized = SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO);
+    }
+    if (sdl_initialized != true)
     {
         spdlog::error("Failed to initialize SDL: {}", SDL_GetError());
         return false;
@@ -164,7 +378,8 @@ bool GameApp::initSDL()
     spdlog::info("Created window: Island (1280x720)");
 
     spdlog::trace("Creating renderer...");
-    sdl_renderer_ = SDL_CreateRenderer(window_, nullptr);
+    // headless runs always measure the CPU rasterizer, whatever the machine has
+    sdl_renderer_ = SDL_CreateRenderer(window_, config_->headless_ ? "software" : nullptr);
     if (sdl_renderer_ == nullptr)
     {
         spdlog::error("Failed to create renderer: {}", SDL_GetError());
@@ -193,6 +408,19 @@ bool GameApp::initTime()
         return false;
     }
     time_->setTargetFps(config_->target_fps_);
+    time_->setFixedTickRate(config_->tick_rate_, config_->max_ticks_per_frame_);
+    if (config_->frame_pacing_ == "sleep")
+    {
+        time_->setPacingMode(PacingMode::SLEEP);
+    }
+    else
+    {
+        if (config_->frame_pacing_ != "hybrid")
+        {
+            spdlog::warn("Unknown frame pacing \"{}\", using hybrid", config_->frame_pacing_);
+        }
+        time_->setPacingMode(PacingMode::HYBRID, static_cast<Uint64>(config_->spin_margin_us_) * 1000);
+    }
     spdlog::info("Initialized Time");
     return true;
 }
@@ -209,6 +437,16 @@ bool GameApp::initResourceManager()
         spdlog::error("Failed to initialize ResourceManager: {}", e.what());
         return false;
     }
+    resource_manager_->setTextureUploadBudget(config_->texture_upload_budget_ms_, static_cast<size_t>(config_->texture_upload_budget_kb_) * 1024);
+    resource_manager_->setTextureMemoryBudget(static_cast<size_t>(config_->texture_memory_budget_mb_) * 1024 * 1024);
+    if (!config_->asset_archive_.empty())
+    {
+        resource_manager_->openArchive(SOURCE_DIR + config_->asset_archive_);
+    }
+    if (!config_->sound_cache_dir_.empty())
+    {
+        resource_manager_->setSoundCacheDirectory(SOURCE_DIR + config_->sound_cache_dir_);
+    }
     spdlog::info("Initialized ResourceManager");
     return true;
 }
@@ -218,12 +456,18 @@ bool GameApp::initRenderer()
     try
     {
         renderer_ = std::make_unique<engine::render::Renderer>(sdl_renderer_, resource_manager_.get());
+        text_renderer_ = std::make_unique<engine::render::TextRenderer>(renderer_.get());
     }
     catch (const std::exception& e)
     {
         spdlog::error("Failed to initialize Renderer: {}", e.what());
         return false;
     }
+    renderer_->setBatchingEnabled(config_->sprite_batching_);
+    renderer_->setDeferred(config_->deferred_rendering_);
+    renderer_->setUICacheEnabled(config_->ui_cache_enabled_);
+    renderer_->setAsyncTextureLoading(config_->async_texture_loading_);
+    renderer_->setLayerSortMode(1, engine::render::LayerSortMode::Y_DEPTH);
     spdlog::info("Initialized Renderer");
     return true;
 }
@@ -233,12 +477,15 @@ bool GameApp::initCamera()
     try
     {
         camera_ = std::make_unique<engine::render::Camera>(glm::vec2{config_->window_width_ / 2, config_->window_height_ / 2});
+        render_camera_ = std::make_unique<engine::render::Camera>(camera_->getViewportSize(), camera_->getPosition());
     }
     catch (const std::exception& e)
     {
         spdlog::error("Failed to initialize Camera: {}", e.what());
         return false;
     }
+    previous_camera_position_ = camera_->getPosition();
+    snapshots_.fill({camera_->getPosition(), camera_->getPosition(), 1.0f});
     spdlog::info("Initialized Camera");
     return true;
 }
@@ -258,6 +505,24 @@ bool GameApp::initInputManager()
     return true;
 }
 
+bool GameApp::initSimulationThread()
+{
+    if (!config_->pipelined_simulation_)
+        return true;
+
+    try
+    {
+        simulation_thread_ = std::make_unique<ThreadPool>(1);
+    }
+    catch (const std::exception& e)
+    {
+        spdlog::error("Failed to initialize simulation thread: {}", e.what());
+        return false;
+    }
+    spdlog::info("Initialized simulation thread, simulation runs one frame ahead of rendering");
+    return true;
+}
+
 void GameApp::testResourceManager()
 {
     if (!resource_manager_)
@@ -272,7 +537,7 @@ void GameApp::testResourceManager()
     if (texture)
     {
         spdlog::info("Loaded texture: {}", texture_path);
-        glm::vec2 size = resource_manager_->getTextureSize(texture_path);
+        glm::vec2 size = resource_manager_->getTextureSize(engine::resource::AssetId::fromPath(texture_path));
         spdlog::info("Texture {} size: {}x{}", texture_path, size.x, size.y);
     }
     else
@@ -280,6 +545,155 @@ void GameApp::testResourceManager()
         spdlog::error("Failed to load texture: {}", texture_path);
     }
 
+    // Test atlas packing
+    if (config_->texture_atlas_enabled_)
+    {
+        const std::vector<std::string> atlas_paths = {
+            SOURCE_DIR "assets/textures/Actors/frog.png",
+            SOURCE_DIR "assets/textures/Actors/opossum.png",
+            SOURCE_DIR "assets/textures/Items/cherry.png",
+            SOURCE_DIR "assets/textures/Items/gem.png",
+            SOURCE_DIR "assets/textures/UI/buttons/Start1.png",
+            SOURCE_DIR "assets/textures/UI/buttons/Start2.png",
+            SOURCE_DIR "assets/textures/UI/buttons/Start3.png",
+        };
+        if (resource_manager_->buildTextureAtlas("test", atlas_paths, config_->texture_atlas_page_size_))
+        {
+            auto stats = resource_manager_->getTextureAtlasStats("test");
+            spdlog::info("Atlas test: {} textures, {} pages, occupancy {:.1f}%", stats.texture_count, stats.page_count, stats.occupancy * 100.0f);
+        }
+        else
+        {
+            spdlog::error("Failed to build atlas: test");
+        }
+    }
+
+    // Test level manifest preloading, the second level keeps the assets both share
+    for (const char* map_path : {SOURCE_DIR "assets/maps/level1.tmj", SOURCE_DIR "assets/maps/level2.tmj"})
+    {
+        engine::resource::LevelManifest manifest;
+        if (!manifest.build(map_path))
+        {
+            spdlog::error("Failed to build level manifest: {}", map_path);
+            continue;
+        }
+        manifest.addFont(SOURCE_DIR "assets/fonts/VonwaonBitmap-16px.ttf", 24);
+        if (!resource_manager_->preloadLevel(manifest))
+        {
+            spdlog::warn("Some assets of {} failed to preload", map_path);
+        }
+    }
+
+    // Test binary level loading, the .lvl files come from the convert_maps target
+    engine::level::LevelData level;
+    if (engine::level::readBinaryLevel(SOURCE_DIR "assets/maps/level1.lvl", level))
+    {
+        spdlog::info("Binary level test: {}x{} tiles, {} layers, {} tilesets", level.getMapSize().x, level.getMapSize().y, level.getLayers().size(), level.getTilesets().size());
+    }
+
+    // Test streaming the Tiled map itself, testRenderer draws its image layers
+    level_ = std::make_unique<engine::level::LevelData>();
+    engine::level::LevelLoader level_loader(SOURCE_DIR);
+    if (!level_loader.load(SOURCE_DIR "assets/maps/level1.tmj", *level_))
+    {
+        level_.reset();
+    }
+    if (level_)
+    {
+        for (const auto& layer : level_->getLayers())
+        {
+            const engine::level::ParallaxLayer* parallax = level_->getParallaxLayer(layer);
+            parallax_sprites_.push_back(parallax ? std::make_optional<engine::render::Sprite>(SOURCE_DIR + std::string(level_->getString(parallax->image))) : std::nullopt);
+        }
+    }
+
+    // Test the chunked tile layers, testRenderer draws them between the image layers
+    if (level_)
+    {
+        tile_graphics_ = std::make_unique<engine::render::TileGraphicTable>();
+        for (const auto& tileset : level_->getTilesets())
+        {
+            if (tileset.columns > 0)
+            {
+                tile_graphics_->addTileSheet(tileset.first_gid, SOURCE_DIR + std::string(level_->getString(tileset.image)), static_cast<int>(tileset.tile_count), static_cast<int>(tileset.columns), tileset.tile_size, static_cast<int>(tileset.margin), static_cast<int>(tileset.spacing));
+                continue;
+            }
+            for (const auto& info : level_->getTileInfos(tileset))
+            {
+                if (info.image.length > 0)
+                {
+                    tile_graphics_->addImageTile(info.gid, SOURCE_DIR + std::string(level_->getString(info.image)), glm::vec2(info.image_size));
+                }
+            }
+        }
+
+        for (const auto& layer : level_->getLayers())
+        {
+            std::unique_ptr<engine::render::TileLayerRenderer> tile_layer;
+            if (layer.kind == engine::level::LayerKind::TILE)
+            {
+                try
+                {
+                    tile_layer = std::make_unique<engine::render::TileLayerRenderer>(renderer_.get(), resource_manager_.get(), tile_graphics_.get(), glm::ivec2(layer.width, layer.height), level_->getTileSize(), level_->getTileGids(layer), 256, layer.offset);
+                }
+                catch (const std::exception& e)
+                {
+                    spdlog::error("Failed to create tile layer {}: {}", level_->getString(layer.name), e.what());
+                }
+            }
+            tile_layers_.push_back(std::move(tile_layer));
+        }
+
+        // Test the visibility index, tile objects are anchored bottom-left; like the collision grid it ignores layer offsets
+        visibility_index_ = std::make_unique<engine::render::VisibilityIndex>();
+        for (const auto& layer : level_->getLayers())
+        {
+            auto objects = level_->getObjects(layer);
+            for (uint32_t i = 0; i < objects.size(); ++i)
+            {
+                if (objects.gids[i] == 0 || !objects.visible[i] || !layer.visible)
+                    continue;
+                const engine::render::TileGraphic* graphic = tile_graphics_->find(objects.gids[i]);
+                if (!graphic)
+                    continue;
+                const SDL_FRect& src = graphic->source_rect;
+                glm::vec2 position = objects.positions[i] - glm::vec2(0.0f, objects.sizes[i].y);
+                visibility_index_->addStatic(engine::utils::Rect{position, objects.sizes[i]}, static_cast<uint32_t>(object_sprites_.size()));
+                object_sprites_.push_back({engine::render::Sprite(engine::resource::AssetId::getPath(graphic->texture_id), src, (objects.gids[i] & engine::render::TILE_FLIPPED_HORIZONTALLY) != 0), position, objects.sizes[i] / glm::vec2(src.w, src.h)});
+            }
+        }
+    }
+
+    // Test the collision grid, tile objects are anchored bottom-left
+    collision_grid_ = std::make_unique<engine::level::CollisionGrid>();
+    if (level_ && collision_grid_->build(*level_))
+    {
+        for (const auto& layer : level_->getLayers())
+        {
+            auto objects = level_->getObjects(layer);
+            for (size_t i = 0; i < objects.size(); ++i)
+            {
+                if (level_->getString(objects.names[i]) != "player")
+                    continue;
+                glm::vec2 position = objects.positions[i] - glm::vec2(0.0f, objects.sizes[i].y);
+                auto ground = collision_grid_->probeGround(position, objects.sizes[i], 512.0f);
+                spdlog::info("Collision grid test: player is {} px above the ground", ground ? *ground : -1.0f);
+            }
+        }
+    }
+
+    // Test parallel sound preloading
+    const std::vector<std::string> sound_paths = {
+        SOURCE_DIR "assets/audio/button_click.wav",
+        SOURCE_DIR "assets/audio/button_hover.wav",
+        SOURCE_DIR "assets/audio/cartoon-jump-6462.mp3",
+        SOURCE_DIR "assets/audio/dead-8bit-41400.mp3",
+        SOURCE_DIR "assets/audio/frog_quak-81741.mp3",
+        SOURCE_DIR "assets/audio/punch2a.mp3",
+    };
+    size_t preloaded = resource_manager_->preloadSounds(sound_paths);
+    spdlog::info("Preloaded {}/{} sounds", preloaded, sound_paths.size());
+
     // Test sound loading
     const std::string sound_path = SOURCE_DIR "assets/audio/monster.mp3";
     MIX_Audio* sound = resource_manager_->loadSound(sound_path);
@@ -322,26 +736,63 @@ void GameApp::testRenderer()
 {
     engine::render::Sprite sprite_world(SOURCE_DIR "assets/textures/Actors/frog.png");
     engine::render::Sprite sprite_ui(SOURCE_DIR "assets/textures/UI/buttons/Start1.png");
-    engine::render::Sprite sprite_parallad(SOURCE_DIR "assets/textures/Layers/back.png");
 
     static float rotation = 0.0f;
     rotation += 0.1f;
 
-    renderer_->drawParallax(*camera_, sprite_parallad, glm::vec2(100.0f, 100.0f), glm::vec2(0.5f, 0.5f), glm::bvec2(true, false));
-    renderer_->drawSprite(*camera_, sprite_world, glm::vec2(200.0f, 200.0f), glm::vec2(1.0f, 1.0f), rotation);
+    renderer_->setLayer(0);
+    if (level_)
+    {
+        const auto& layers = level_->getLayers();
+        for (size_t i = 0; i < layers.size(); ++i)
+        {
+            const auto& layer = layers[i];
+            if (!layer.visible)
+                continue;
+            if (i < tile_layers_.size() && tile_layers_[i])
+            {
+                tile_layers_[i]->draw(*render_camera_);
+                continue;
+            }
+            const engine::level::ParallaxLayer* parallax = level_->getParallaxLayer(layer);
+            if (!parallax || i >= parallax_sprites_.size() || !parallax_sprites_[i])
+                continue;
+            renderer_->drawParallax(*render_camera_, *parallax_sprites_[i], parallax->position, parallax->scroll_factor, parallax->getRepeat());
+        }
+    }
+    renderer_->setLayer(1);
+    if (visibility_index_)
+    {
+        for (uint32_t index : visibility_index_->queryVisible(*render_camera_))
+        {
+            const ObjectSprite& object = object_sprites_[index];
+            renderer_->drawSprite(*render_camera_, object.sprite, object.position, object.scale);
+        }
+    }
+    renderer_->drawSprite(*render_camera_, sprite_world, glm::vec2(200.0f, 200.0f), glm::vec2(1.0f, 1.0f), rotation);
+    if (input_manager_->isActionPressed("MouseLeftClick"))
+    {
+        renderer_->markUIDirty(SDL_FRect{100.0f, 100.0f, 64.0f, 32.0f});
+    }
     renderer_->drawUISprite(sprite_ui, glm::vec2(100.0f, 100.0f));
+
+    TTF_Font* font = resource_manager_->getMFont(SOURCE_DIR "assets/fonts/VonwaonBitmap-16px.ttf", 24);
+    auto stats = renderer_->getLastFrameStats();
+    const auto& memory = resource_manager_->getTextureMemoryStats();
+    text_renderer_->drawText("test.stats", font, fmt::format("draw calls: {} sprites: {} ui rebuilds/s: {:.1f}", stats.draw_calls, stats.sprites, renderer_->getUIRebuildsPerSecond()), glm::vec2(10.0f, 10.0f));
+    text_renderer_->drawText("test.memory", font, fmt::format("textures: {:.1f} MB (peak {:.1f}) evictions: {}", memory.current_bytes / 1048576.0, memory.peak_bytes / 1048576.0, memory.evictions), glm::vec2(10.0f, 30.0f));
 }
 
 void GameApp::testCamera()
 {
-    auto key_state = SDL_GetKeyboardState(nullptr);
-    if (key_state[SDL_SCANCODE_UP])
+    // action states are only written by InputManager::update on the main thread, between simulations
+    if (input_manager_->isActionDown("move_up"))
         camera_->move(glm::vec2(0.0f, -1.0f));
-    if (key_state[SDL_SCANCODE_DOWN])
+    if (input_manager_->isActionDown("move_down"))
         camera_->move(glm::vec2(0.0f, 1.0f));
-    if (key_state[SDL_SCANCODE_LEFT])
+    if (input_manager_->isActionDown("move_left"))
         camera_->move(glm::vec2(-1.0f, 0.0f));
-    if (key_state[SDL_SCANCODE_RIGHT])
+    if (input_manager_->isActionDown("move_right"))
         camera_->move(glm::vec2(1.0f, 0.0f));
 }
 
@@ -1,8 +1,16 @@
 #pragma once
 
+#include <array>
+#include <future>
 #include <memory>
+#include <optional>
+#include <vector>
+
+#include <SDL3/SDL_stdinc.h>
+#include <glm/vec2.hpp>
 
 #include "engine/input/InputManager.hpp"
+#include "engine/render/Sprite.hpp"
 
 struct SDL_Window;
 struct SDL_Renderer;
@@ -16,12 +24,24 @@ namespace engine::render
 {
 class Renderer;
 class Camera;
+class TextRenderer;
+class TileGraphicTable;
+class TileLayerRenderer;
+class VisibilityIndex;
 } // namespace engine::render
 
+namespace engine::level
+{
+class LevelData;
+class CollisionGrid;
+} // namespace engine::level
+
 namespace engine::core
 {
 class Time;
 class Config;
+class FrameStats;
+class ThreadPool;
 } // namespace engine::core
 
 namespace engine::input
@@ -40,6 +60,10 @@ private:
     SDL_Renderer* sdl_renderer_ = nullptr;
     bool is_running_ = false;
 
+    // command line overrides, applied on top of config.json
+    bool cli_headless_ = false;
+    int cli_frames_ = -1;
+
     //
     std::unique_ptr<engine::core::Config> config_;
     std::unique_ptr<engine::core::Time> time_;
@@ -48,9 +72,49 @@ private:
 
     std::unique_ptr<engine::render::Renderer> renderer_;
     std::unique_ptr<engine::render::Camera> camera_;
+    // camera_ belongs to the simulation, render_camera_ is it interpolated between the last two ticks
+    std::unique_ptr<engine::render::Camera> render_camera_;
+    glm::vec2 previous_camera_position_ = {0.0f, 0.0f};
+
+    // everything render() needs from the simulation; the simulation writes the back one, render reads the front
+    struct RenderSnapshot
+    {
+        glm::vec2 camera_position = {0.0f, 0.0f};
+        glm::vec2 previous_camera_position = {0.0f, 0.0f};
+        float alpha = 1.0f;
+    };
+    std::array<RenderSnapshot, 2> snapshots_;
+    size_t front_snapshot_ = 0;
+
+    // pipelined mode: the next frame's simulation runs here while the main thread renders
+    std::unique_ptr<engine::core::ThreadPool> simulation_thread_;
+    std::future<void> pending_simulation_;
+    std::unique_ptr<engine::render::TextRenderer> text_renderer_;
 
     std::unique_ptr<engine::input::InputManager> input_manager_;
 
+    std::unique_ptr<engine::level::LevelData> level_;
+    std::unique_ptr<engine::level::CollisionGrid> collision_grid_;
+    std::unique_ptr<engine::render::TileGraphicTable> tile_graphics_;
+    // one per level layer, nullptr for non-tile layers
+    std::vector<std::unique_ptr<engine::render::TileLayerRenderer>> tile_layers_;
+    // one per level layer, empty for non-image layers
+    std::vector<std::optional<engine::render::Sprite>> parallax_sprites_;
+    // a visible tile object of the level, built once at load so drawing it does no lookups
+    struct ObjectSprite
+    {
+        engine::render::Sprite sprite;
+        glm::vec2 position = {0.0f, 0.0f};
+        glm::vec2 scale = {1.0f, 1.0f};
+    };
+    // the level's tile objects, user data is the index in object_sprites_
+    std::unique_ptr<engine::render::VisibilityIndex> visibility_index_;
+    std::vector<ObjectSprite> object_sprites_;
+
+    // only present for benchmark runs
+    std::unique_ptr<engine::core::FrameStats> frame_stats_;
+    int frame_count_ = 0;
+
 public:
     GameApp();
     ~GameApp();
@@ -60,13 +124,20 @@ public:
     GameApp(GameApp&&) = delete;
     GameApp& operator=(GameApp&&) = delete;
 
+    // --headless, --frames <n>
+    [[nodiscard]] bool parseCommandLine(int argc, char* argv[]);
     void run();
 
 private:
     [[nodiscard]] bool init();
     void handleEvent();
     void update(float delta_time);
+    // one simulation step, remembers the state render() interpolates from
+    void tick(float delta_time);
+    void simulate(int ticks, float delta_time, float alpha);
+    void publishSnapshot();
     void render();
+    void recordFrame(Uint64 frame_start, Uint64 input_end, Uint64 events_end, Uint64 update_end, Uint64 render_end, Uint64 present_end, Uint64 frame_end);
     void close();
 
     [[nodiscard]] bool initConfig();
@@ -76,6 +147,7 @@ private:
     [[nodiscard]] bool initRenderer();
     [[nodiscard]] bool initCamera();
     [[nodiscard]] bool initInputManager();
+    [[nodiscard]] bool initSimulationThread();
 
     void testResourceManager();
     void testRenderer();
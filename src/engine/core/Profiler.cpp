@@ -0,0 +1,146 @@
+#include "Profiler.hpp"
+
+#include <array>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+#include <SDL3/SDL_timer.h>
+
+namespace engine::core
+{
+
+namespace
+{
+constexpr size_t RING_CAPACITY = 1 << 16;
+
+// single producer (the owning thread), single consumer (the dumping thread)
+struct ThreadBuffer
+{
+    std::array<ProfileEvent, RING_CAPACITY> events;
+    std::atomic<size_t> head{0};
+    std::atomic<size_t> tail{0};
+    std::atomic<size_t> dropped{0};
+    int thread_index = 0;
+};
+
+struct Registry
+{
+    std::mutex mutex;
+    // buffers outlive their threads so late dumps still see the events
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+};
+
+Registry& getRegistry()
+{
+    static Registry registry;
+    return registry;
+}
+
+ThreadBuffer* getThreadBuffer()
+{
+    thread_local ThreadBuffer* buffer = nullptr;
+    if (buffer == nullptr)
+    {
+        auto& registry = getRegistry();
+        std::lock_guard lock(registry.mutex);
+        registry.buffers.push_back(std::make_unique<ThreadBuffer>());
+        buffer = registry.buffers.back().get();
+        buffer->thread_index = static_cast<int>(registry.buffers.size());
+    }
+    return buffer;
+}
+} // namespace
+
+std::atomic<bool> Profiler::enabled_{false};
+
+void Profiler::setEnabled(bool enabled)
+{
+    enabled_.store(enabled, std::memory_order_relaxed);
+    spdlog::info("Profiler {}", enabled ? "enabled" : "disabled");
+}
+
+void Profiler::record(const char* name, Uint64 start_ns, Uint64 end_ns)
+{
+    ThreadBuffer* buffer = getThreadBuffer();
+    size_t head = buffer->head.load(std::memory_order_relaxed);
+    if (head - buffer->tail.load(std::memory_order_acquire) >= RING_CAPACITY)
+    {
+        // keep what is already buffered, a dump will make room
+        buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    buffer->events[head % RING_CAPACITY] = {name, start_ns, end_ns};
+    buffer->head.store(head + 1, std::memory_order_release);
+}
+
+bool Profiler::dumpChromeTrace(const std::string& file_path)
+{
+    nlohmann::json trace_events = nlohmann::json::array();
+    {
+        auto& registry = getRegistry();
+        std::lock_guard lock(registry.mutex);
+        for (const auto& buffer : registry.buffers)
+        {
+            size_t tail = buffer->tail.load(std::memory_order_relaxed);
+            size_t head = buffer->head.load(std::memory_order_acquire);
+            for (size_t i = tail; i < head; ++i)
+            {
+                const ProfileEvent& event = buffer->events[i % RING_CAPACITY];
+                trace_events.push_back({
+                    {"name", event.name},
+                    {"ph", "X"},
+                    {"ts", static_cast<double>(event.start_ns) / 1000.0},
+                    {"dur", static_cast<double>(event.end_ns - event.start_ns) / 1000.0},
+                    {"pid", 1},
+                    {"tid", buffer->thread_index},
+                });
+            }
+            buffer->tail.store(head, std::memory_order_release);
+        }
+    }
+
+    std::ofstream file(file_path);
+    if (!file.is_open())
+    {
+        spdlog::error("Profiler: failed to open {} for writing", file_path);
+        return false;
+    }
+    file << nlohmann::json{{"traceEvents", std::move(trace_events)}, {"displayTimeUnit", "ms"}}.dump();
+    spdlog::info("Profiler: trace written to {} ({} events dropped so far)", file_path, getDroppedEventCount());
+    return true;
+}
+
+size_t Profiler::getDroppedEventCount()
+{
+    auto& registry = getRegistry();
+    std::lock_guard lock(registry.mutex);
+    size_t dropped = 0;
+    for (const auto& buffer : registry.buffers)
+    {
+        dropped += buffer->dropped.load(std::memory_order_relaxed);
+    }
+    return dropped;
+}
+
+ProfileScope::ProfileScope(const char* name)
+    : name_(name)
+{
+    if (Profiler::isEnabled())
+    {
+        start_ns_ = SDL_GetTicksNS();
+    }
+}
+
+ProfileScope::~ProfileScope()
+{
+    if (start_ns_ != 0)
+    {
+        Profiler::record(name_, start_ns_, SDL_GetTicksNS());
+    }
+}
+
+} // namespace engine::core
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <string>
+
+#include <SDL3/SDL_stdinc.h>
+
+// ISLAND_PROFILE_SCOPE("name") times the enclosing scope. Names must be string literals, only the pointer is stored.
+// Configure with -DISLAND_ENABLE_PROFILER=OFF to compile every marker out.
+#if defined(ISLAND_ENABLE_PROFILER) && ISLAND_ENABLE_PROFILER
+#define ISLAND_PROFILE_CONCAT_INNER(a, b) a##b
+#define ISLAND_PROFILE_CONCAT(a, b) ISLAND_PROFILE_CONCAT_INNER(a, b)
+#define ISLAND_PROFILE_SCOPE(name) ::engine::core::ProfileScope ISLAND_PROFILE_CONCAT(island_profile_scope_, __LINE__)(name)
+#else
+#define ISLAND_PROFILE_SCOPE(name) ((void)0)
+#endif
+
+namespace engine::core
+{
+
+struct ProfileEvent
+{
+    const char* name = nullptr;
+    Uint64 start_ns = 0;
+    Uint64 end_ns = 0;
+};
+
+// Scoped CPU markers collected into per-thread ring buffers and exported as Chrome trace JSON
+// (chrome://tracing, ui.perfetto.dev). Disabled by default, a disabled marker costs one relaxed load.
+class Profiler final
+{
+private:
+    static std::atomic<bool> enabled_;
+
+public:
+    Profiler() = delete;
+
+    static void setEnabled(bool enabled);
+    static bool isEnabled() { return enabled_.load(std::memory_order_relaxed); }
+
+    static void record(const char* name, Uint64 start_ns, Uint64 end_ns);
+
+    // drains every thread's buffer into a trace file, events are consumed
+    static bool dumpChromeTrace(const std::string& file_path);
+    static size_t getDroppedEventCount();
+};
+
+class ProfileScope final
+{
+private:
+    const char* name_;
+    Uint64 start_ns_ = 0;
+
+public:
+    explicit ProfileScope(const char* name);
+    ~ProfileScope();
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+    ProfileScope(ProfileScope&&) = delete;
+    ProfileScope& operator=(ProfileScope&&) = delete;
+};
+
+} // namespace engine::core
@@ -0,0 +1,61 @@
+#include "ThreadPool.hpp"
+
+#include <stdexcept>
+
+#include <spdlog/spdlog.h>
+
+namespace engine::core
+{
+
+ThreadPool::ThreadPool(size_t thread_count)
+{
+    if (thread_count == 0)
+    {
+        throw std::runtime_error("Failed to construct ThreadPool: thread_count is 0");
+    }
+
+    workers_.reserve(thread_count);
+    for (size_t i = 0; i < thread_count; ++i)
+    {
+        workers_.emplace_back(&ThreadPool::workerLoop, this);
+    }
+    spdlog::trace("ThreadPool constructed with {} threads", thread_count);
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard lock(mutex_);
+        stopping_ = true;
+    }
+    condition_.notify_all();
+    for (auto& worker : workers_)
+    {
+        worker.join();
+    }
+}
+
+size_t ThreadPool::getDefaultThreadCount()
+{
+    unsigned int hardware_threads = std::thread::hardware_concurrency();
+    return hardware_threads > 1 ? hardware_threads - 1 : 1;
+}
+
+void ThreadPool::workerLoop()
+{
+    while (true)
+    {
+        std::function<void()> task;
+        {
+            std::unique_lock lock(mutex_);
+            condition_.wait(lock, [this]() { return stopping_ || !tasks_.empty(); });
+            if (tasks_.empty())
+                return;
+            task = std::move(tasks_.front());
+            tasks_.pop_front();
+        }
+        task();
+    }
+}
+
+} // namespace engine::core
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace engine::core
+{
+
+// fixed set of worker threads draining one FIFO queue; queued tasks still run when the pool is destroyed
+class ThreadPool final
+{
+private:
+    std::vector<std::thread> workers_;
+    std::deque<std::function<void()>> tasks_;
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    bool stopping_ = false;
+
+public:
+    explicit ThreadPool(size_t thread_count);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    ThreadPool(ThreadPool&&) = delete;
+    ThreadPool& operator=(ThreadPool&&) = delete;
+
+    template <typename F>
+    std::future<std::invoke_result_t<F>> submit(F&& task)
+    {
+        using Result = std::invoke_result_t<F>;
+        auto packaged = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(task));
+        std::future<Result> future = packaged->get_future();
+        {
+            std::lock_guard lock(mutex_);
+            tasks_.emplace_back([packaged]() { (*packaged)(); });
+        }
+        condition_.notify_one();
+        return future;
+    }
+
+    size_t getThreadCount() const { return workers_.size(); }
+
+    // hardware threads minus the main thread, at least one
+    static size_t getDefaultThreadCount();
+
+private:
+    void workerLoop();
+};
+
+} // namespace engine::core
@@ -1,5 +1,7 @@
 #include "Time.hpp"
 
+#include <thread>
+
 #include <spdlog/spdlog.h>
 #include <SDL3/SDL_timer.h>
 
@@ -14,19 +16,128 @@ Time::Time()
 void Time::update()
 {
     Uint64 current_tick = SDL_GetTicksNS();
-    Uint64 current_delta_tick = current_tick - last_tick_ns_;
-    if (target_frame_ns_ > 0 && current_delta_tick < target_frame_ns_)
+    if (target_frame_ns_ > 0)
+    {
+        if (next_deadline_ns_ == 0)
+        {
+            next_deadline_ns_ = last_tick_ns_ + target_frame_ns_;
+        }
+
+        if (current_tick < next_deadline_ns_)
+        {
+            waitUntil(next_deadline_ns_);
+            current_tick = SDL_GetTicksNS();
+        }
+        recordLateness(current_tick - next_deadline_ns_);
+
+        next_deadline_ns_ += target_frame_ns_;
+        if (next_deadline_ns_ <= current_tick)
+        {
+            // a frame ran long: resync rather than racing through catch-up frames
+            next_deadline_ns_ = current_tick + target_frame_ns_;
+        }
+    }
+
+    delta_time_ns_ = current_tick - last_tick_ns_;
+    last_tick_ns_ = current_tick;
+
+    if (fixed_tick_ns_ > 0)
+    {
+        accumulator_ns_ += static_cast<Uint64>(static_cast<double>(delta_time_ns_) * time_scale_);
+    }
+}
+
+void Time::setFixedTickRate(int tick_rate, int max_ticks_per_frame)
+{
+    if (tick_rate < 0 || max_ticks_per_frame <= 0)
+    {
+        spdlog::warn("tick_rate need \">= 0\" and max_ticks_per_frame \"> 0\"");
+        return;
+    }
+
+    fixed_tick_ns_ = tick_rate == 0 ? 0 : 1000'000'000 / static_cast<Uint64>(tick_rate);
+    max_ticks_per_frame_ = max_ticks_per_frame;
+    accumulator_ns_ = 0;
+}
+
+int Time::consumeFixedTicks()
+{
+    if (fixed_tick_ns_ == 0)
+        return 0;
+
+    Uint64 ticks = accumulator_ns_ / fixed_tick_ns_;
+    if (ticks > static_cast<Uint64>(max_ticks_per_frame_))
     {
-        SDL_DelayNS(target_frame_ns_ - current_delta_tick);
-        current_tick = SDL_GetTicksNS();
-        delta_time_ns_ = current_tick - last_tick_ns_;
+        // drop the backlog but keep the phase inside the current tick
+        dropped_ticks_ += ticks - max_ticks_per_frame_;
+        ticks = max_ticks_per_frame_;
+        accumulator_ns_ %= fixed_tick_ns_;
     }
     else
     {
-        delta_time_ns_ = current_delta_tick;
+        accumulator_ns_ -= ticks * fixed_tick_ns_;
     }
+    return static_cast<int>(ticks);
+}
 
-    last_tick_ns_ = current_tick;
+float Time::getFixedDeltaTime() const
+{
+    return static_cast<float>(fixed_tick_ns_) / 1'000'000'000.0f;
+}
+
+float Time::getInterpolationAlpha() const
+{
+    if (fixed_tick_ns_ == 0)
+        return 1.0f;
+    return static_cast<float>(accumulator_ns_) / static_cast<float>(fixed_tick_ns_);
+}
+
+void Time::waitUntil(Uint64 deadline_ns)
+{
+    // the caller checked an earlier tick, the deadline may have passed since
+    Uint64 now = SDL_GetTicksNS();
+    if (now >= deadline_ns)
+    {
+        return;
+    }
+
+    Uint64 remaining_ns = deadline_ns - now;
+    if (pacing_mode_ == PacingMode::SLEEP)
+    {
+        SDL_DelayNS(remaining_ns);
+        return;
+    }
+
+    if (remaining_ns > spin_margin_ns_)
+    {
+        SDL_DelayNS(remaining_ns - spin_margin_ns_);
+    }
+    while (SDL_GetTicksNS() < deadline_ns)
+    {
+        std::this_thread::yield();
+    }
+}
+
+void Time::recordLateness(Uint64 lateness_ns)
+{
+    ++pacing_stats_.frames;
+    pacing_stats_.total_lateness_ns += lateness_ns;
+    if (lateness_ns > pacing_stats_.max_lateness_ns)
+    {
+        pacing_stats_.max_lateness_ns = lateness_ns;
+    }
+
+    Uint64 lateness_us = lateness_ns / 1000;
+    size_t bucket = 0;
+    while (bucket < PacingStats::BUCKET_LIMITS_US.size() && lateness_us >= PacingStats::BUCKET_LIMITS_US[bucket])
+    {
+        ++bucket;
+    }
+    ++pacing_stats_.histogram[bucket];
+    if (lateness_us >= 1000)
+    {
+        ++pacing_stats_.missed_deadlines;
+    }
 }
 
 float Time::getDeltaTime() const
@@ -50,6 +161,7 @@ void Time::setTargetFps(int target_fps)
     }
 
     target_fps_ = target_fps;
+    next_deadline_ns_ = 0;
 
     if (target_fps == 0)
     {
@@ -65,4 +177,47 @@ int Time::getTargetFps() const
     return target_fps_;
 }
 
+void Time::setPacingMode(PacingMode mode, Uint64 spin_margin_ns)
+{
+    pacing_mode_ = mode;
+    spin_margin_ns_ = spin_margin_ns;
+}
+
+PacingMode Time::getPacingMode() const
+{
+    return pacing_mode_;
+}
+
+const PacingStats &Time::getPacingStats() const
+{
+    return pacing_stats_;
+}
+
+void Time::resetPacingStats()
+{
+    pacing_stats_ = {};
+}
+
+void Time::logPacingStats() const
+{
+    const auto &stats = pacing_stats_;
+    if (stats.frames == 0)
+        return;
+
+    spdlog::info("Frame pacing ({}): {} frames, {} missed deadlines, mean lateness {:.1f} us, max {:.1f} us", pacing_mode_ == PacingMode::HYBRID ? "hybrid" : "sleep", stats.frames, stats.missed_deadlines, static_cast<double>(stats.total_lateness_ns) / static_cast<double>(stats.frames) / 1000.0, static_cast<double>(stats.max_lateness_ns) / 1000.0);
+    Uint64 lower = 0;
+    for (size_t i = 0; i < stats.histogram.size(); ++i)
+    {
+        if (i < PacingStats::BUCKET_LIMITS_US.size())
+        {
+            spdlog::info("  {:>5}-{:<5} us: {}", lower, PacingStats::BUCKET_LIMITS_US[i], stats.histogram[i]);
+            lower = PacingStats::BUCKET_LIMITS_US[i];
+        }
+        else
+        {
+            spdlog::info("  {:>5}+      us: {}", lower, stats.histogram[i]);
+        }
+    }
+}
+
 } // namespace engine::core
@@ -1,9 +1,30 @@
 #pragma once
 
+#include <array>
+
 #include <SDL3/SDL_stdinc.h>
 
 namespace engine::core
 {
+
+enum class PacingMode
+{
+    SLEEP,  // one SDL_DelayNS to the deadline, cheap but at the mercy of the scheduler
+    HYBRID, // sleep to a safety margin before the deadline, then spin
+};
+
+struct PacingStats
+{
+    // upper bounds (µs) of the lateness histogram buckets, the last bucket takes everything above
+    static constexpr std::array<Uint64, 7> BUCKET_LIMITS_US = {50, 100, 250, 500, 1000, 2000, 4000};
+
+    Uint64 frames = 0;
+    Uint64 missed_deadlines = 0; // frames that woke up more than one bucket step (1 ms) late
+    Uint64 total_lateness_ns = 0;
+    Uint64 max_lateness_ns = 0;
+    std::array<Uint64, BUCKET_LIMITS_US.size() + 1> histogram = {};
+};
+
 class Time final
 {
 private:
@@ -13,6 +34,18 @@ private:
     int target_fps_ = 0;
     Uint64 target_frame_ns_ = 0;
 
+    PacingMode pacing_mode_ = PacingMode::HYBRID;
+    Uint64 spin_margin_ns_ = 2'000'000;
+    // absolute, so an oversleep on one frame is taken out of the next one instead of accumulating
+    Uint64 next_deadline_ns_ = 0;
+    PacingStats pacing_stats_;
+
+    // fixed-step simulation, disabled while fixed_tick_ns_ == 0
+    Uint64 fixed_tick_ns_ = 0;
+    int max_ticks_per_frame_ = 5;
+    Uint64 accumulator_ns_ = 0;
+    Uint64 dropped_ticks_ = 0;
+
 public:
     Time();
 
@@ -30,5 +63,24 @@ public:
 
     void setTargetFps(int target_fps);
     int getTargetFps() const;
+
+    void setFixedTickRate(int tick_rate, int max_ticks_per_frame = 5);
+    bool isFixedStep() const { return fixed_tick_ns_ > 0; }
+    // number of simulation ticks due this frame, capped so a long frame can't snowball into longer ones
+    int consumeFixedTicks();
+    float getFixedDeltaTime() const;
+    // how far the leftover time is into the next tick, for interpolating render state
+    float getInterpolationAlpha() const;
+    Uint64 getDroppedTicks() const { return dropped_ticks_; }
+
+    void setPacingMode(PacingMode mode, Uint64 spin_margin_ns = 2'000'000);
+    PacingMode getPacingMode() const;
+    const PacingStats &getPacingStats() const;
+    void resetPacingStats();
+    void logPacingStats() const;
+
+private:
+    void waitUntil(Uint64 deadline_ns);
+    void recordLateness(Uint64 lateness_ns);
 };
 } // namespace engine::core
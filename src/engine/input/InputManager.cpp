@@ -40,6 +40,7 @@ void InputManager::update()
         }
     }
 
+    render_targets_reset_ = false;
     SDL_Event event;
     while (SDL_PollEvent(&event))
     {
@@ -91,6 +92,10 @@ void InputManager::processEvent(const SDL_Event& event)
     case SDL_EVENT_QUIT:
         should_quit_ = true;
         break;
+    case SDL_EVENT_RENDER_TARGETS_RESET:
+    case SDL_EVENT_RENDER_DEVICE_RESET:
+        render_targets_reset_ = true;
+        break;
     default:
         break;
     }
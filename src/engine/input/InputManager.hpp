@@ -35,6 +35,7 @@ private:
     std::unordered_map<std::string, ActionState> action_states_;
 
     bool should_quit_ = false;
+    bool render_targets_reset_ = false; // this frame
     glm::vec2 mouse_position_;
 
 public:
@@ -49,6 +50,8 @@ public:
 
     bool shouldQuit() const;
     void setShouldQuit(bool should_quit);
+    // target textures lost their contents since the last update (device lost, window moved to another GPU...)
+    bool wereRenderTargetsReset() const { return render_targets_reset_; }
 
     glm::vec2 getMousePosition() const;
     glm::vec2 getLogicalMousePosition() const;
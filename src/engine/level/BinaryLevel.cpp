@@ -0,0 +1,149 @@
+#include "BinaryLevel.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <type_traits>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+#include "engine/utils/MappedFile.hpp"
+
+namespace engine::level
+{
+
+namespace
+{
+
+constexpr uint64_t SECTION_ALIGNMENT = 16;
+
+static_assert(std::is_trivially_copyable_v<LayerData> && std::is_trivially_copyable_v<ParallaxLayer> && std::is_trivially_copyable_v<PropertyData> && std::is_trivially_copyable_v<TilesetData> && std::is_trivially_copyable_v<TileInfo>);
+
+template <typename Container>
+bool readSection(const engine::utils::MappedFile& file, const LevelSectionDesc& desc, Container& out)
+{
+    using T = typename Container::value_type;
+    if (desc.offset > file.getSize() || desc.count > (file.getSize() - desc.offset) / sizeof(T))
+        return false;
+    out.resize(static_cast<size_t>(desc.count));
+    if (desc.count > 0)
+    {
+        std::memcpy(out.data(), file.getData() + desc.offset, static_cast<size_t>(desc.count) * sizeof(T));
+    }
+    return true;
+}
+
+template <typename Container>
+void writeSection(std::ofstream& out, const Container& data, LevelSectionDesc& desc)
+{
+    using T = typename Container::value_type;
+    static const char zeros[SECTION_ALIGNMENT] = {};
+    uint64_t position = static_cast<uint64_t>(out.tellp());
+    out.write(zeros, static_cast<std::streamsize>((SECTION_ALIGNMENT - position % SECTION_ALIGNMENT) % SECTION_ALIGNMENT));
+
+    desc.offset = static_cast<uint64_t>(out.tellp());
+    desc.count = data.size();
+    out.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size() * sizeof(T)));
+}
+
+} // namespace
+
+bool readBinaryLevel(std::string_view path, LevelData& level)
+{
+    auto start = std::chrono::steady_clock::now();
+    level.clear();
+
+    engine::utils::MappedFile file;
+    if (!file.open(path))
+    {
+        return false;
+    }
+
+    BinaryLevelHeader header;
+    if (file.getSize() < sizeof(header))
+    {
+        spdlog::error("BinaryLevel: {} is truncated", path);
+        return false;
+    }
+    std::memcpy(&header, file.getData(), sizeof(header));
+    if (std::memcmp(header.magic, BINARY_LEVEL_MAGIC, sizeof(BINARY_LEVEL_MAGIC)) != 0 || header.version != BINARY_LEVEL_VERSION)
+    {
+        spdlog::error("BinaryLevel: {} is not a version {} level", path, BINARY_LEVEL_VERSION);
+        return false;
+    }
+
+    auto section = [&](LevelSection s) -> const LevelSectionDesc& { return header.sections[static_cast<size_t>(s)]; };
+    bool ok = readSection(file, section(LevelSection::LAYERS), level.layers_) && readSection(file, section(LevelSection::TILES), level.tiles_) && readSection(file, section(LevelSection::PARALLAX_LAYERS), level.parallax_layers_);
+    ok = ok && readSection(file, section(LevelSection::OBJECT_IDS), level.object_ids_) && readSection(file, section(LevelSection::OBJECT_GIDS), level.object_gids_) && readSection(file, section(LevelSection::OBJECT_POSITIONS), level.object_positions_) && readSection(file, section(LevelSection::OBJECT_SIZES), level.object_sizes_) && readSection(file, section(LevelSection::OBJECT_ROTATIONS), level.object_rotations_) && readSection(file, section(LevelSection::OBJECT_NAMES), level.object_names_) && readSection(file, section(LevelSection::OBJECT_TYPES), level.object_types_) && readSection(file, section(LevelSection::OBJECT_VISIBLE), level.object_visible_) && readSection(file, section(LevelSection::OBJECT_PROPERTIES), level.object_properties_);
+    ok = ok && readSection(file, section(LevelSection::PROPERTIES), level.properties_) && readSection(file, section(LevelSection::TILESETS), level.tilesets_) && readSection(file, section(LevelSection::TILE_INFOS), level.tile_infos_) && readSection(file, section(LevelSection::STRINGS), level.strings_);
+    // every object array must have one entry per object
+    size_t objects = level.object_ids_.size();
+    ok = ok && level.object_gids_.size() == objects && level.object_positions_.size() == objects && level.object_sizes_.size() == objects && level.object_rotations_.size() == objects && level.object_names_.size() == objects && level.object_types_.size() == objects && level.object_visible_.size() == objects && level.object_properties_.size() == objects;
+    // flags stored as bytes must be 0 or 1
+    ok = ok && std::all_of(level.parallax_layers_.begin(), level.parallax_layers_.end(), [](const ParallaxLayer& layer) { return layer.repeat_x <= 1 && layer.repeat_y <= 1; });
+    ok = ok && std::all_of(level.object_visible_.begin(), level.object_visible_.end(), [](uint8_t visible) { return visible <= 1; });
+    if (!ok)
+    {
+        spdlog::error("BinaryLevel: {} has a section past the end of the file, mismatched object arrays or invalid flags", path);
+        level.clear();
+        return false;
+    }
+
+    level.source_path_ = std::string(path);
+    level.map_size_ = header.map_size;
+    level.tile_size_ = header.tile_size;
+    level.map_properties_ = header.map_properties;
+
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    spdlog::info("BinaryLevel: loaded {} in {} us ({} layers, {} tiles, {} objects, {} KB)", path, elapsed.count(), level.layers_.size(), level.tiles_.size(), level.object_ids_.size(), level.getMemoryUsage() / 1024);
+    return true;
+}
+
+bool writeBinaryLevel(const LevelData& level, std::string_view path)
+{
+    std::ofstream out(std::string(path), std::ios::binary | std::ios::trunc);
+    if (!out)
+    {
+        spdlog::error("BinaryLevel: cannot write {}", path);
+        return false;
+    }
+
+    BinaryLevelHeader header{};
+    std::memcpy(header.magic, BINARY_LEVEL_MAGIC, sizeof(header.magic));
+    header.version = BINARY_LEVEL_VERSION;
+    header.map_size = level.map_size_;
+    header.tile_size = level.tile_size_;
+    header.map_properties = level.map_properties_;
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    auto section = [&](LevelSection s) -> LevelSectionDesc& { return header.sections[static_cast<size_t>(s)]; };
+    writeSection(out, level.layers_, section(LevelSection::LAYERS));
+    writeSection(out, level.tiles_, section(LevelSection::TILES));
+    writeSection(out, level.parallax_layers_, section(LevelSection::PARALLAX_LAYERS));
+    writeSection(out, level.object_ids_, section(LevelSection::OBJECT_IDS));
+    writeSection(out, level.object_gids_, section(LevelSection::OBJECT_GIDS));
+    writeSection(out, level.object_positions_, section(LevelSection::OBJECT_POSITIONS));
+    writeSection(out, level.object_sizes_, section(LevelSection::OBJECT_SIZES));
+    writeSection(out, level.object_rotations_, section(LevelSection::OBJECT_ROTATIONS));
+    writeSection(out, level.object_names_, section(LevelSection::OBJECT_NAMES));
+    writeSection(out, level.object_types_, section(LevelSection::OBJECT_TYPES));
+    writeSection(out, level.object_visible_, section(LevelSection::OBJECT_VISIBLE));
+    writeSection(out, level.object_properties_, section(LevelSection::OBJECT_PROPERTIES));
+    writeSection(out, level.properties_, section(LevelSection::PROPERTIES));
+    writeSection(out, level.tilesets_, section(LevelSection::TILESETS));
+    writeSection(out, level.tile_infos_, section(LevelSection::TILE_INFOS));
+    writeSection(out, level.strings_, section(LevelSection::STRINGS));
+
+    out.seekp(0);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    if (!out)
+    {
+        spdlog::error("BinaryLevel: failed while writing {}", path);
+        return false;
+    }
+    return true;
+}
+
+} // namespace engine::level
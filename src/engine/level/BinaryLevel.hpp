@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+#include "engine/level/LevelData.hpp"
+
+namespace engine::level
+{
+
+// .lvl layout, native (little endian) byte order, written by tools/map_converter:
+//   BinaryLevelHeader | section payloads, each 16 byte aligned
+// Each section is one of LevelData's arrays stored as is, so loading is one mapping plus a copy per array.
+inline constexpr char BINARY_LEVEL_MAGIC[8] = {'I', 'S', 'L', 'L', 'V', 'L', '0', '1'};
+inline constexpr uint32_t BINARY_LEVEL_VERSION = 1;
+
+enum class LevelSection : uint32_t
+{
+    LAYERS = 0,
+    TILES,
+    PARALLAX_LAYERS,
+    OBJECT_IDS,
+    OBJECT_GIDS,
+    OBJECT_POSITIONS,
+    OBJECT_SIZES,
+    OBJECT_ROTATIONS,
+    OBJECT_NAMES,
+    OBJECT_TYPES,
+    OBJECT_VISIBLE,
+    OBJECT_PROPERTIES,
+    PROPERTIES,
+    TILESETS,
+    TILE_INFOS,
+    STRINGS,
+    COUNT,
+};
+
+struct LevelSectionDesc
+{
+    uint64_t offset = 0;
+    uint64_t count = 0; // elements, bytes for STRINGS
+};
+
+struct BinaryLevelHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t reserved;
+    glm::ivec2 map_size;
+    glm::ivec2 tile_size;
+    PropertyRange map_properties;
+    LevelSectionDesc sections[static_cast<size_t>(LevelSection::COUNT)];
+};
+
+// Both log and return false on failure; a failed read leaves the level cleared.
+bool readBinaryLevel(std::string_view path, LevelData& level);
+bool writeBinaryLevel(const LevelData& level, std::string_view path);
+
+} // namespace engine::level
@@ -0,0 +1,453 @@
+#include "CollisionGrid.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <string_view>
+#include <utility>
+
+#include <spdlog/spdlog.h>
+
+#include "engine/level/LevelData.hpp"
+
+namespace engine::level
+{
+
+namespace
+{
+
+// a box touching a tile edge is not inside the tile
+constexpr float EDGE_EPSILON = 0.001f;
+constexpr int CLASS_BITS = 4;
+constexpr int CELLS_PER_CLASS_WORD = 64 / CLASS_BITS;
+
+constexpr std::array<std::pair<std::string_view, TileCollision>, 6> SLOPES = {{
+    {"0_1", TileCollision::SLOPE_0_1},
+    {"1_0", TileCollision::SLOPE_1_0},
+    {"0_2", TileCollision::SLOPE_0_2},
+    {"2_0", TileCollision::SLOPE_2_0},
+    {"1_2", TileCollision::SLOPE_1_2},
+    {"2_1", TileCollision::SLOPE_2_1},
+}};
+
+bool isSlope(TileCollision collision)
+{
+    return collision >= TileCollision::SLOPE_0_1;
+}
+
+// the mirrored slope is the neighbouring value
+TileCollision mirrorSlope(TileCollision collision)
+{
+    return static_cast<TileCollision>(static_cast<uint8_t>(collision) ^ 1u);
+}
+
+// surface height at the left and right edge, in tiles
+glm::vec2 slopeHeights(TileCollision collision)
+{
+    switch (collision)
+    {
+    case TileCollision::SLOPE_0_1: return {0.0f, 1.0f};
+    case TileCollision::SLOPE_1_0: return {1.0f, 0.0f};
+    case TileCollision::SLOPE_0_2: return {0.0f, 0.5f};
+    case TileCollision::SLOPE_2_0: return {0.5f, 0.0f};
+    case TileCollision::SLOPE_1_2: return {1.0f, 0.5f};
+    case TileCollision::SLOPE_2_1: return {0.5f, 1.0f};
+    default: return {0.0f, 0.0f};
+    }
+}
+
+TileCollision classify(const LevelData& level, PropertyRange properties)
+{
+    auto flag = [&](std::string_view name)
+    {
+        const PropertyData* property = level.findProperty(properties, name);
+        return property && property->type == PropertyType::BOOL && property->int_value != 0;
+    };
+    if (flag("solid"))
+        return TileCollision::SOLID;
+    if (flag("unisolid"))
+        return TileCollision::UNISOLID;
+    if (flag("ladder"))
+        return TileCollision::LADDER;
+    if (const PropertyData* slope = level.findProperty(properties, "slope"))
+    {
+        std::string_view value = level.getString(slope->string_value);
+        for (const auto& [name, collision] : SLOPES)
+        {
+            if (value == name)
+                return collision;
+        }
+        spdlog::warn("CollisionGrid: unknown slope \"{}\"", value);
+    }
+    return TileCollision::EMPTY;
+}
+
+// first/last set bit of a row within columns [x0, x1], -1 if there is none
+int findFirst(const uint64_t* row, int x0, int x1)
+{
+    const int first_word = x0 >> 6;
+    const int last_word = x1 >> 6;
+    for (int w = first_word; w <= last_word; ++w)
+    {
+        uint64_t bits = row[w];
+        if (w == first_word)
+            bits &= ~0ull << (x0 & 63);
+        if (w == last_word)
+            bits &= ~0ull >> (63 - (x1 & 63));
+        if (bits)
+            return (w << 6) + std::countr_zero(bits);
+    }
+    return -1;
+}
+
+int findLast(const uint64_t* row, int x0, int x1)
+{
+    const int first_word = x0 >> 6;
+    const int last_word = x1 >> 6;
+    for (int w = last_word; w >= first_word; --w)
+    {
+        uint64_t bits = row[w];
+        if (w == first_word)
+            bits &= ~0ull << (x0 & 63);
+        if (w == last_word)
+            bits &= ~0ull >> (63 - (x1 & 63));
+        if (bits)
+            return (w << 6) + 63 - std::countl_zero(bits);
+    }
+    return -1;
+}
+
+} // namespace
+
+bool CollisionGrid::build(const LevelData& level)
+{
+    clear();
+    const glm::ivec2 map_size = level.getMapSize();
+    const glm::ivec2 tile_size = level.getTileSize();
+    if (map_size.x <= 0 || map_size.y <= 0 || tile_size.x <= 0 || tile_size.y <= 0)
+    {
+        spdlog::error("CollisionGrid: {} has no map or tile size", level.getSourcePath());
+        return false;
+    }
+
+    // the only place tile properties are looked at
+    std::vector<TileCollision> gid_collision(LEVEL_TILE_GID_MASK + 1u, TileCollision::EMPTY);
+    for (const auto& tileset : level.getTilesets())
+    {
+        for (const auto& info : level.getTileInfos(tileset))
+        {
+            if (info.gid <= LEVEL_TILE_GID_MASK)
+            {
+                gid_collision[info.gid] = classify(level, info.properties);
+            }
+        }
+    }
+
+    size_ = map_size;
+    tile_size_ = glm::vec2(tile_size);
+    class_words_per_row_ = (static_cast<size_t>(size_.x) + CELLS_PER_CLASS_WORD - 1) / CELLS_PER_CLASS_WORD;
+    bit_words_per_row_ = (static_cast<size_t>(size_.x) + 63) / 64;
+    classes_.assign(class_words_per_row_ * size_.y, 0);
+
+    int merged = 0;
+    for (const auto& layer : level.getLayers())
+    {
+        if (layer.kind != LayerKind::TILE)
+            continue;
+        if (static_cast<int>(layer.width) != size_.x || static_cast<int>(layer.height) != size_.y)
+        {
+            spdlog::warn("CollisionGrid: skipping layer {}, it is not the size of the map", level.getString(layer.name));
+            continue;
+        }
+        auto tiles = level.getTiles(layer);
+        for (size_t i = 0; i < tiles.size(); ++i)
+        {
+            TileCollision collision = gid_collision[tiles[i] & LEVEL_TILE_GID_MASK];
+            if (collision == TileCollision::EMPTY)
+                continue;
+            if (isSlope(collision) && (tiles[i] & LEVEL_TILE_FLIPPED_HORIZONTALLY))
+            {
+                collision = mirrorSlope(collision);
+            }
+            setCell(static_cast<int>(i % size_.x), static_cast<int>(i / size_.x), collision);
+        }
+        ++merged;
+    }
+    if (merged == 0)
+    {
+        spdlog::error("CollisionGrid: {} has no tile layer the size of the map", level.getSourcePath());
+        clear();
+        return false;
+    }
+
+    const size_t bit_words = bit_words_per_row_ * size_.y;
+    solid_.assign(bit_words, 0);
+    floor_.assign(bit_words, 0);
+    slope_.assign(bit_words, 0);
+    ladder_.assign(bit_words, 0);
+    for (int y = 0; y < size_.y; ++y)
+    {
+        for (int x = 0; x < size_.x; ++x)
+        {
+            const size_t word = static_cast<size_t>(y) * bit_words_per_row_ + (x >> 6);
+            const uint64_t bit = 1ull << (x & 63);
+            switch (getCell(x, y))
+            {
+            case TileCollision::EMPTY: break;
+            case TileCollision::SOLID:
+                solid_[word] |= bit;
+                floor_[word] |= bit;
+                break;
+            case TileCollision::UNISOLID: floor_[word] |= bit; break;
+            case TileCollision::LADDER: ladder_[word] |= bit; break;
+            default: slope_[word] |= bit; break;
+            }
+        }
+    }
+
+    spdlog::info("CollisionGrid: {}x{} cells, {} solid, {} KB", size_.x, size_.y, getSolidCellCount(), getMemoryUsage() / 1024);
+    return true;
+}
+
+void CollisionGrid::clear()
+{
+    size_ = {0, 0};
+    tile_size_ = {0.0f, 0.0f};
+    class_words_per_row_ = 0;
+    bit_words_per_row_ = 0;
+    classes_.clear();
+    solid_.clear();
+    floor_.clear();
+    slope_.clear();
+    ladder_.clear();
+}
+
+TileCollision CollisionGrid::getCell(int x, int y) const
+{
+    if (x < 0 || y < 0 || x >= size_.x || y >= size_.y)
+        return TileCollision::EMPTY;
+    const uint64_t word = classes_[static_cast<size_t>(y) * class_words_per_row_ + x / CELLS_PER_CLASS_WORD];
+    return static_cast<TileCollision>((word >> ((x % CELLS_PER_CLASS_WORD) * CLASS_BITS)) & 0xFu);
+}
+
+size_t CollisionGrid::getSolidCellCount() const
+{
+    size_t count = 0;
+    for (uint64_t word : solid_)
+    {
+        count += static_cast<size_t>(std::popcount(word));
+    }
+    return count;
+}
+
+size_t CollisionGrid::getMemoryUsage() const
+{
+    return (classes_.capacity() + solid_.capacity() + floor_.capacity() + slope_.capacity() + ladder_.capacity()) * sizeof(uint64_t);
+}
+
+bool CollisionGrid::overlapsSolid(const glm::vec2& position, const glm::vec2& size) const
+{
+    return anyInRect(solid_, position, size);
+}
+
+bool CollisionGrid::overlapsLadder(const glm::vec2& position, const glm::vec2& size) const
+{
+    return anyInRect(ladder_, position, size);
+}
+
+CollisionSweep CollisionGrid::sweep(const glm::vec2& position, const glm::vec2& size, const glm::vec2& delta) const
+{
+    CollisionSweep result;
+    bool hit = false;
+    result.delta.x = sweepX(position, size, delta.x, hit);
+    result.hit_left = hit && delta.x < 0.0f;
+    result.hit_right = hit && delta.x > 0.0f;
+
+    const glm::vec2 moved = {position.x + result.delta.x, position.y};
+    if (delta.y < 0.0f)
+    {
+        result.delta.y = sweepUp(moved, size, delta.y, hit);
+        result.hit_ceiling = hit;
+    }
+    else
+    {
+        result.delta.y = sweepDown(moved, size, delta.y, hit);
+        result.on_ground = hit;
+    }
+    return result;
+}
+
+std::optional<float> CollisionGrid::probeGround(const glm::vec2& position, const glm::vec2& size, float max_distance) const
+{
+    bool hit = false;
+    float distance = sweepDown(position, size, max_distance, hit);
+    if (!hit)
+        return std::nullopt;
+    return distance;
+}
+
+void CollisionGrid::setCell(int x, int y, TileCollision collision)
+{
+    uint64_t& word = classes_[static_cast<size_t>(y) * class_words_per_row_ + x / CELLS_PER_CLASS_WORD];
+    const int shift = (x % CELLS_PER_CLASS_WORD) * CLASS_BITS;
+    word = (word & ~(0xFull << shift)) | (static_cast<uint64_t>(collision) << shift);
+}
+
+int CollisionGrid::toColumn(float x) const
+{
+    return static_cast<int>(std::floor(x / tile_size_.x));
+}
+
+int CollisionGrid::toRow(float y) const
+{
+    return static_cast<int>(std::floor(y / tile_size_.y));
+}
+
+bool CollisionGrid::anyInRect(const std::vector<uint64_t>& bits, const glm::vec2& position, const glm::vec2& size) const
+{
+    if (bits.empty())
+        return false;
+    const int x0 = std::max(toColumn(position.x), 0);
+    const int x1 = std::min(toColumn(position.x + size.x - EDGE_EPSILON), size_.x - 1);
+    const int y0 = std::max(toRow(position.y), 0);
+    const int y1 = std::min(toRow(position.y + size.y - EDGE_EPSILON), size_.y - 1);
+    if (x0 > x1)
+        return false;
+    for (int y = y0; y <= y1; ++y)
+    {
+        if (findFirst(row(bits, y), x0, x1) >= 0)
+            return true;
+    }
+    return false;
+}
+
+float CollisionGrid::sweepX(const glm::vec2& position, const glm::vec2& size, float dx, bool& hit) const
+{
+    hit = false;
+    if (dx == 0.0f || solid_.empty())
+        return dx;
+    const int y0 = std::max(toRow(position.y), 0);
+    const int y1 = std::min(toRow(position.y + size.y - EDGE_EPSILON), size_.y - 1);
+
+    if (dx > 0.0f)
+    {
+        const float right = position.x + size.x;
+        const int first = std::max(toColumn(right - EDGE_EPSILON) + 1, 0);
+        const int last = std::min(toColumn(right + dx - EDGE_EPSILON), size_.x - 1);
+        // each row only needs to be searched up to the nearest wall found so far
+        int nearest = last + 1;
+        for (int y = y0; y <= y1 && first < nearest; ++y)
+        {
+            int x = findFirst(row(solid_, y), first, nearest - 1);
+            if (x >= 0)
+                nearest = x;
+        }
+        if (nearest <= last)
+        {
+            hit = true;
+            return nearest * tile_size_.x - right;
+        }
+    }
+    else
+    {
+        const float left = position.x;
+        const int first = std::min(toColumn(left) - 1, size_.x - 1);
+        const int last = std::max(toColumn(left + dx), 0);
+        int nearest = last - 1;
+        for (int y = y0; y <= y1 && nearest < first; ++y)
+        {
+            int x = findLast(row(solid_, y), nearest + 1, first);
+            if (x >= 0)
+                nearest = x;
+        }
+        if (nearest >= last)
+        {
+            hit = true;
+            return (nearest + 1) * tile_size_.x - left;
+        }
+    }
+    return dx;
+}
+
+float CollisionGrid::sweepUp(const glm::vec2& position, const glm::vec2& size, float dy, bool& hit) const
+{
+    hit = false;
+    if (solid_.empty())
+        return dy;
+    const int x0 = std::max(toColumn(position.x), 0);
+    const int x1 = std::min(toColumn(position.x + size.x - EDGE_EPSILON), size_.x - 1);
+    if (x0 > x1)
+        return dy;
+
+    const float top = position.y;
+    const int first = std::min(toRow(top) - 1, size_.y - 1);
+    const int last = std::max(toRow(top + dy), 0);
+    for (int y = first; y >= last; --y)
+    {
+        if (findFirst(row(solid_, y), x0, x1) >= 0)
+        {
+            hit = true;
+            return (y + 1) * tile_size_.y - top;
+        }
+    }
+    return dy;
+}
+
+float CollisionGrid::sweepDown(const glm::vec2& position, const glm::vec2& size, float dy, bool& hit) const
+{
+    hit = false;
+    if (floor_.empty())
+        return dy;
+    const float left = position.x;
+    const float right = position.x + size.x;
+    const int x0 = std::max(toColumn(left), 0);
+    const int x1 = std::min(toColumn(right - EDGE_EPSILON), size_.x - 1);
+    if (x0 > x1)
+        return dy;
+
+    // whole tiles and one-way platforms, only rows below the one the bottom is in, so a box standing inside a
+    // one-way platform falls through it; a tile top exactly at the bottom counts as ground
+    const float bottom = position.y + size.y;
+    float allowed = dy;
+    const int first = std::max(toRow(bottom - EDGE_EPSILON) + 1, 0);
+    const int last = std::min(toRow(bottom + dy), size_.y - 1);
+    for (int y = first; y <= last; ++y)
+    {
+        if (findFirst(row(floor_, y), x0, x1) >= 0)
+        {
+            allowed = y * tile_size_.y - bottom;
+            hit = true;
+            break;
+        }
+    }
+
+    // slopes: the highest surface under the box, from one tile above the bottom down to the ground found above
+    const int slope_first = std::max(toRow(bottom - tile_size_.y), 0);
+    const int slope_last = std::min(toRow(bottom + allowed), size_.y - 1);
+    for (int y = slope_first; y <= slope_last; ++y)
+    {
+        const uint64_t* slopes = row(slope_, y);
+        float highest = std::numeric_limits<float>::max();
+        for (int x = findFirst(slopes, x0, x1); x >= 0; x = x < x1 ? findFirst(slopes, x + 1, x1) : -1)
+        {
+            // the surface is a line, so its highest point under the box is at one of the box's edges
+            const glm::vec2 heights = slopeHeights(getCell(x, y));
+            const float cell_left = x * tile_size_.x;
+            const float a = std::clamp((left - cell_left) / tile_size_.x, 0.0f, 1.0f);
+            const float b = std::clamp((right - cell_left) / tile_size_.x, 0.0f, 1.0f);
+            const float height = std::max(heights.x + (heights.y - heights.x) * a, heights.x + (heights.y - heights.x) * b) * tile_size_.y;
+            highest = std::min(highest, (y + 1) * tile_size_.y - height);
+        }
+        if (highest >= bottom - tile_size_.y && highest <= bottom + allowed)
+        {
+            allowed = highest - bottom;
+            hit = true;
+            break;
+        }
+    }
+    return allowed;
+}
+
+} // namespace engine::level
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include <glm/vec2.hpp>
+
+namespace engine::level
+{
+
+class LevelData;
+
+// Collision class of a cell, from the tileset's tile properties. Slopes are named like the "slope" property, after
+// the surface height at the left and right edge of the tile: 0 none, 1 a full tile, 2 half a tile.
+enum class TileCollision : uint8_t
+{
+    EMPTY = 0,
+    SOLID = 1,    // "solid"
+    UNISOLID = 2, // "unisolid", only blocks from above
+    LADDER = 3,   // "ladder"
+    SLOPE_0_1 = 4,
+    SLOPE_1_0 = 5,
+    SLOPE_0_2 = 6,
+    SLOPE_2_0 = 7,
+    SLOPE_1_2 = 8,
+    SLOPE_2_1 = 9,
+};
+
+// What CollisionGrid::sweep() let a box do.
+struct CollisionSweep
+{
+    glm::vec2 delta = {0.0f, 0.0f}; // the part of the movement that is free
+    bool hit_left = false;
+    bool hit_right = false;
+    bool hit_ceiling = false;
+    bool on_ground = false;
+};
+
+// The tile layers of a level reduced to collision: 4 bits per cell (16 cells per word, row-major) for getCell(),
+// plus one bitset per row for each kind of cell the queries look for. The queries test whole words of a row at a
+// time, so their cost grows with the rows a box covers, not with the tiles it covers; tile properties are only
+// read while building. Boxes are position (top-left) and size in map pixels; layer offsets are not applied and
+// everything outside the map is empty.
+class CollisionGrid final
+{
+private:
+    glm::ivec2 size_ = {0, 0};           // in tiles
+    glm::vec2 tile_size_ = {0.0f, 0.0f}; // in pixels
+    size_t class_words_per_row_ = 0;
+    size_t bit_words_per_row_ = 0;
+
+    std::vector<uint64_t> classes_;
+    std::vector<uint64_t> solid_;
+    std::vector<uint64_t> floor_; // solid or unisolid, what a falling box lands on
+    std::vector<uint64_t> slope_;
+    std::vector<uint64_t> ladder_;
+
+public:
+    CollisionGrid() = default;
+
+    CollisionGrid(const CollisionGrid&) = delete;
+    CollisionGrid& operator=(const CollisionGrid&) = delete;
+    CollisionGrid(CollisionGrid&&) = delete;
+    CollisionGrid& operator=(CollisionGrid&&) = delete;
+
+    // Merges every tile layer of the map's size, a later layer's cell wins where it has a collision class.
+    // Horizontally flipped slopes are mirrored. Logs and returns false if the level has no usable tile layer.
+    bool build(const LevelData& level);
+    void clear();
+
+    const glm::ivec2& getSize() const { return size_; }
+    const glm::vec2& getTileSize() const { return tile_size_; }
+    TileCollision getCell(int x, int y) const;
+    size_t getSolidCellCount() const;
+    // heap bytes held by the grid
+    size_t getMemoryUsage() const;
+
+    // AABB-vs-grid overlap
+    bool overlapsSolid(const glm::vec2& position, const glm::vec2& size) const;
+    bool overlapsLadder(const glm::vec2& position, const glm::vec2& size) const;
+
+    // Moves the box by delta, x first then y. Solid cells block both ways, unisolid cells only a box falling onto
+    // them from above; a box that is not moving up follows slopes under it, up to one tile upwards.
+    CollisionSweep sweep(const glm::vec2& position, const glm::vec2& size, const glm::vec2& delta) const;
+
+    // Distance from the bottom of the box down to what it would stand on, within max_distance. Negative if the
+    // box has sunk into a slope. nullopt if there is nothing in range.
+    std::optional<float> probeGround(const glm::vec2& position, const glm::vec2& size, float max_distance) const;
+
+private:
+    void setCell(int x, int y, TileCollision collision);
+    const uint64_t* row(const std::vector<uint64_t>& bits, int y) const { return bits.data() + static_cast<size_t>(y) * bit_words_per_row_; }
+    // cell of a pixel coordinate, not clamped to the grid
+    int toColumn(float x) const;
+    int toRow(float y) const;
+    bool anyInRect(const std::vector<uint64_t>& bits, const glm::vec2& position, const glm::vec2& size) const;
+
+    float sweepX(const glm::vec2& position, const glm::vec2& size, float dx, bool& hit) const;
+    float sweepUp(const glm::vec2& position, const glm::vec2& size, float dy, bool& hit) const;
+    // how far the bottom of the box can move down (negative: up onto a slope)
+    float sweepDown(const glm::vec2& position, const glm::vec2& size, float dy, bool& hit) const;
+};
+
+} // namespace engine::level
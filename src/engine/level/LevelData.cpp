@@ -0,0 +1,178 @@
+#include "LevelData.hpp"
+
+#include <algorithm>
+
+namespace engine::level
+{
+
+void LevelData::clear()
+{
+    source_path_.clear();
+    map_size_ = {0, 0};
+    tile_size_ = {0, 0};
+    map_properties_ = {};
+    layers_.clear();
+    tiles_.clear();
+    parallax_layers_.clear();
+    object_ids_.clear();
+    object_gids_.clear();
+    object_positions_.clear();
+    object_sizes_.clear();
+    object_rotations_.clear();
+    object_names_.clear();
+    object_types_.clear();
+    object_visible_.clear();
+    object_properties_.clear();
+    properties_.clear();
+    tilesets_.clear();
+    tile_infos_.clear();
+    strings_.clear();
+    string_lookup_.clear();
+}
+
+const LayerData* LevelData::findLayer(std::string_view name) const
+{
+    auto it = std::find_if(layers_.begin(), layers_.end(), [&](const LayerData& layer) { return getString(layer.name) == name; });
+    return it != layers_.end() ? &*it : nullptr;
+}
+
+std::span<const uint16_t> LevelData::getTiles(const LayerData& layer) const
+{
+    if (layer.kind != LayerKind::TILE || layer.first + static_cast<size_t>(layer.count) > tiles_.size())
+        return {};
+    return std::span<const uint16_t>(tiles_).subspan(layer.first, layer.count);
+}
+
+std::vector<uint32_t> LevelData::getTileGids(const LayerData& layer) const
+{
+    auto tiles = getTiles(layer);
+    std::vector<uint32_t> gids(tiles.size());
+    std::transform(tiles.begin(), tiles.end(), gids.begin(), unpackTileGid);
+    return gids;
+}
+
+const ParallaxLayer* LevelData::getParallaxLayer(const LayerData& layer) const
+{
+    if (layer.kind != LayerKind::IMAGE || layer.first >= parallax_layers_.size())
+        return nullptr;
+    return &parallax_layers_[layer.first];
+}
+
+ObjectArrays LevelData::getObjects(const LayerData& layer) const
+{
+    if (layer.kind != LayerKind::OBJECT || layer.first + static_cast<size_t>(layer.count) > object_ids_.size())
+        return {};
+    return sliceObjects(layer.first, layer.count);
+}
+
+ObjectArrays LevelData::getAllObjects() const
+{
+    return sliceObjects(0, getObjectCount());
+}
+
+ObjectArrays LevelData::sliceObjects(uint32_t first, uint32_t count) const
+{
+    ObjectArrays objects;
+    objects.ids = std::span<const uint32_t>(object_ids_).subspan(first, count);
+    objects.gids = std::span<const uint32_t>(object_gids_).subspan(first, count);
+    objects.positions = std::span<const glm::vec2>(object_positions_).subspan(first, count);
+    objects.sizes = std::span<const glm::vec2>(object_sizes_).subspan(first, count);
+    objects.rotations = std::span<const float>(object_rotations_).subspan(first, count);
+    objects.names = std::span<const StringRef>(object_names_).subspan(first, count);
+    objects.types = std::span<const StringRef>(object_types_).subspan(first, count);
+    objects.visible = std::span<const uint8_t>(object_visible_).subspan(first, count);
+    objects.properties = std::span<const PropertyRange>(object_properties_).subspan(first, count);
+    return objects;
+}
+
+std::span<const TileInfo> LevelData::getTileInfos(const TilesetData& tileset) const
+{
+    if (tileset.first_tile_info + static_cast<size_t>(tileset.tile_info_count) > tile_infos_.size())
+        return {};
+    return std::span<const TileInfo>(tile_infos_).subspan(tileset.first_tile_info, tileset.tile_info_count);
+}
+
+std::span<const PropertyData> LevelData::getProperties(PropertyRange range) const
+{
+    if (range.first + static_cast<size_t>(range.count) > properties_.size())
+        return {};
+    return std::span<const PropertyData>(properties_).subspan(range.first, range.count);
+}
+
+const PropertyData* LevelData::findProperty(PropertyRange range, std::string_view name) const
+{
+    for (const auto& property : getProperties(range))
+    {
+        if (getString(property.name) == name)
+            return &property;
+    }
+    return nullptr;
+}
+
+std::string_view LevelData::getString(StringRef ref) const
+{
+    if (ref.offset + static_cast<size_t>(ref.length) > strings_.size())
+        return {};
+    return std::string_view(strings_).substr(ref.offset, ref.length);
+}
+
+size_t LevelData::getMemoryUsage() const
+{
+    size_t objects = object_ids_.capacity() * sizeof(uint32_t) + object_gids_.capacity() * sizeof(uint32_t) + object_positions_.capacity() * sizeof(glm::vec2) + object_sizes_.capacity() * sizeof(glm::vec2) + object_rotations_.capacity() * sizeof(float) + object_names_.capacity() * sizeof(StringRef) + object_types_.capacity() * sizeof(StringRef) + object_visible_.capacity() * sizeof(uint8_t) + object_properties_.capacity() * sizeof(PropertyRange);
+    return layers_.capacity() * sizeof(LayerData) + tiles_.capacity() * sizeof(uint16_t) + parallax_layers_.capacity() * sizeof(ParallaxLayer) + objects + properties_.capacity() * sizeof(PropertyData) + tilesets_.capacity() * sizeof(TilesetData) + tile_infos_.capacity() * sizeof(TileInfo) + strings_.capacity();
+}
+
+void LevelData::setMapSize(const glm::ivec2& map_size, const glm::ivec2& tile_size)
+{
+    map_size_ = map_size;
+    tile_size_ = tile_size;
+}
+
+void LevelData::addObject(const ObjectData& object)
+{
+    object_ids_.push_back(object.id);
+    object_gids_.push_back(object.gid);
+    object_positions_.push_back(object.position);
+    object_sizes_.push_back(object.size);
+    object_rotations_.push_back(object.rotation);
+    object_names_.push_back(object.name);
+    object_types_.push_back(object.type);
+    object_visible_.push_back(object.visible ? 1 : 0);
+    object_properties_.push_back(object.properties);
+}
+
+StringRef LevelData::addString(std::string_view text)
+{
+    if (text.empty())
+        return {};
+    if (auto it = string_lookup_.find(std::string(text)); it != string_lookup_.end())
+        return it->second;
+
+    StringRef ref{static_cast<uint32_t>(strings_.size()), static_cast<uint32_t>(text.size())};
+    strings_.append(text);
+    string_lookup_.emplace(std::string(text), ref);
+    return ref;
+}
+
+void LevelData::finish()
+{
+    string_lookup_.clear();
+    layers_.shrink_to_fit();
+    tiles_.shrink_to_fit();
+    parallax_layers_.shrink_to_fit();
+    object_ids_.shrink_to_fit();
+    object_gids_.shrink_to_fit();
+    object_positions_.shrink_to_fit();
+    object_sizes_.shrink_to_fit();
+    object_rotations_.shrink_to_fit();
+    object_names_.shrink_to_fit();
+    object_types_.shrink_to_fit();
+    object_visible_.shrink_to_fit();
+    object_properties_.shrink_to_fit();
+    properties_.shrink_to_fit();
+    tilesets_.shrink_to_fit();
+    tile_infos_.shrink_to_fit();
+    strings_.shrink_to_fit();
+}
+
+} // namespace engine::level
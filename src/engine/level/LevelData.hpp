@@ -0,0 +1,271 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/vec2.hpp>
+
+namespace engine::level
+{
+
+// Every record below is trivially copyable with a fixed layout, the binary level format stores the arrays as is.
+
+// Tile layers keep 16 bits per cell: Tiled's horizontal/vertical/diagonal flip flags in the top three bits (the
+// same bits as in a 32 bit gid, shifted down by 16), the gid in the low 13. The rotated-hexagonal flag is dropped.
+inline constexpr uint16_t LEVEL_TILE_FLIPPED_HORIZONTALLY = 0x8000u;
+inline constexpr uint16_t LEVEL_TILE_FLIPPED_VERTICALLY = 0x4000u;
+inline constexpr uint16_t LEVEL_TILE_FLIPPED_DIAGONALLY = 0x2000u;
+inline constexpr uint16_t LEVEL_TILE_GID_MASK = 0x1FFFu;
+
+// false if the gid does not fit in 13 bits
+constexpr bool packTileGid(uint32_t tiled_gid, uint16_t& packed)
+{
+    if ((tiled_gid & 0x0FFFFFFFu) > LEVEL_TILE_GID_MASK)
+        return false;
+    packed = static_cast<uint16_t>((tiled_gid & LEVEL_TILE_GID_MASK) | ((tiled_gid >> 16) & 0xE000u));
+    return true;
+}
+
+// back to a Tiled gid with the flags in the top bits
+constexpr uint32_t unpackTileGid(uint16_t packed)
+{
+    return (packed & LEVEL_TILE_GID_MASK) | (static_cast<uint32_t>(packed & 0xE000u) << 16);
+}
+
+// slice of LevelData's string table
+struct StringRef
+{
+    uint32_t offset = 0;
+    uint32_t length = 0;
+};
+
+// a range of LevelData::getProperties()
+struct PropertyRange
+{
+    uint32_t first = 0;
+    uint32_t count = 0;
+};
+
+enum class LayerKind : uint32_t
+{
+    TILE = 0,
+    IMAGE = 1,
+    OBJECT = 2,
+};
+
+// One per drawable layer in draw order. Groups are flattened into their children: offsets add up, opacity and
+// parallax multiply, visibility is and-ed.
+struct LayerData
+{
+    StringRef name;
+    LayerKind kind = LayerKind::TILE;
+    uint32_t visible = 1;
+    float opacity = 1.0f;
+    glm::vec2 offset = {0.0f, 0.0f};
+    glm::vec2 parallax = {1.0f, 1.0f};
+    // TILE: range in getTiles(), OBJECT: range in getObjects(), IMAGE: index in getParallaxLayers()
+    uint32_t first = 0;
+    uint32_t count = 0;
+    // TILE: size in tiles, IMAGE: image size in pixels
+    uint32_t width = 0;
+    uint32_t height = 0;
+    PropertyRange properties;
+};
+
+// An image layer, laid out as Renderer::drawParallax takes it:
+//   renderer.drawParallax(camera, sprite, layer.position, layer.scroll_factor, layer.getRepeat());
+// position is the flattened layer offset, scroll_factor its parallax. The repeat flags are bytes (0 or 1) with
+// explicit padding so the record has no indeterminate bytes when written out.
+struct ParallaxLayer
+{
+    StringRef image;
+    glm::vec2 position = {0.0f, 0.0f};
+    glm::vec2 scroll_factor = {1.0f, 1.0f};
+    uint8_t repeat_x = 0;
+    uint8_t repeat_y = 0;
+    uint8_t padding[2] = {0, 0};
+    glm::ivec2 image_size = {0, 0};
+
+    glm::bvec2 getRepeat() const { return {repeat_x != 0, repeat_y != 0}; }
+};
+static_assert(sizeof(ParallaxLayer) == 36);
+
+// Only used to add an object, LevelData keeps each field in its own array.
+struct ObjectData
+{
+    uint32_t id = 0;
+    uint32_t gid = 0; // tile objects, flip flags included
+    StringRef name;
+    StringRef type;
+    glm::vec2 position = {0.0f, 0.0f};
+    glm::vec2 size = {0.0f, 0.0f};
+    float rotation = 0.0f;
+    uint32_t visible = 1;
+    PropertyRange properties;
+};
+
+enum class PropertyType : uint32_t
+{
+    BOOL = 0,
+    INT = 1,
+    FLOAT = 2,
+    STRING = 3,
+    COLOR = 4,  // int_value holds 0xAARRGGBB
+    FILE = 5,   // string_value, resolved like image paths
+    OBJECT = 6, // int_value holds the object id
+    CLASS = 7,  // string_value holds the members as JSON
+};
+
+struct PropertyData
+{
+    StringRef name;
+    PropertyType type = PropertyType::STRING;
+    uint32_t reserved = 0;
+    int64_t int_value = 0;
+    double float_value = 0.0;
+    StringRef string_value;
+};
+
+// External tilesets are embedded, so a level needs no other file.
+struct TilesetData
+{
+    StringRef name;
+    uint32_t first_gid = 0;
+    uint32_t tile_count = 0;
+    uint32_t columns = 0; // 0 for image collections
+    uint32_t margin = 0;
+    uint32_t spacing = 0;
+    glm::ivec2 tile_size = {0, 0};
+    StringRef image; // empty for image collections
+    glm::ivec2 image_size = {0, 0};
+    // tiles that carry an image or properties, range in getTileInfos()
+    uint32_t first_tile_info = 0;
+    uint32_t tile_info_count = 0;
+};
+
+struct TileInfo
+{
+    uint32_t gid = 0;
+    StringRef image; // image collection tiles
+    glm::ivec2 image_size = {0, 0};
+    PropertyRange properties;
+};
+
+// One object layer's slice of the object arrays, all spans have size() elements.
+struct ObjectArrays
+{
+    std::span<const uint32_t> ids;
+    std::span<const uint32_t> gids; // tile objects, flip flags included
+    std::span<const glm::vec2> positions;
+    std::span<const glm::vec2> sizes;
+    std::span<const float> rotations;
+    std::span<const StringRef> names;
+    std::span<const StringRef> types;
+    std::span<const uint8_t> visible;
+    std::span<const PropertyRange> properties;
+
+    size_t size() const { return ids.size(); }
+    bool empty() const { return ids.empty(); }
+};
+
+// A Tiled map in flat arrays: every tile layer's gids in one uint16_t array, objects split into one array per
+// field, one record per layer/property, and a single string table. Memory grows with the tile count, not with the
+// size of the source JSON. Paths (images, file properties) are relative to the project root, i.e. what follows
+// SOURCE_DIR.
+class LevelData final
+{
+    friend bool readBinaryLevel(std::string_view path, LevelData& level);
+    friend bool writeBinaryLevel(const LevelData& level, std::string_view path);
+
+private:
+    std::string source_path_;
+    glm::ivec2 map_size_ = {0, 0};  // in tiles
+    glm::ivec2 tile_size_ = {0, 0}; // in pixels
+    PropertyRange map_properties_;
+
+    std::vector<LayerData> layers_;
+    std::vector<uint16_t> tiles_;
+    std::vector<ParallaxLayer> parallax_layers_;
+
+    std::vector<uint32_t> object_ids_;
+    std::vector<uint32_t> object_gids_;
+    std::vector<glm::vec2> object_positions_;
+    std::vector<glm::vec2> object_sizes_;
+    std::vector<float> object_rotations_;
+    std::vector<StringRef> object_names_;
+    std::vector<StringRef> object_types_;
+    std::vector<uint8_t> object_visible_;
+    std::vector<PropertyRange> object_properties_;
+
+    std::vector<PropertyData> properties_;
+    std::vector<TilesetData> tilesets_;
+    std::vector<TileInfo> tile_infos_;
+    std::string strings_;
+
+    // build-time only, so repeated strings are stored once
+    std::unordered_map<std::string, StringRef> string_lookup_;
+
+public:
+    LevelData() = default;
+
+    void clear();
+
+    const std::string& getSourcePath() const { return source_path_; }
+    const glm::ivec2& getMapSize() const { return map_size_; }
+    const glm::ivec2& getTileSize() const { return tile_size_; }
+
+    const std::vector<LayerData>& getLayers() const { return layers_; }
+    // nullptr if no layer has that name
+    const LayerData* findLayer(std::string_view name) const;
+    // packed, see packTileGid()
+    std::span<const uint16_t> getTiles(const LayerData& layer) const;
+    // unpacked to Tiled gids, what TileLayerRenderer takes
+    std::vector<uint32_t> getTileGids(const LayerData& layer) const;
+    const std::vector<ParallaxLayer>& getParallaxLayers() const { return parallax_layers_; }
+    // nullptr unless layer is an image layer
+    const ParallaxLayer* getParallaxLayer(const LayerData& layer) const;
+    ObjectArrays getObjects(const LayerData& layer) const;
+    // every layer's objects, an object layer's first indexes into these
+    ObjectArrays getAllObjects() const;
+    const std::vector<TilesetData>& getTilesets() const { return tilesets_; }
+    std::span<const TileInfo> getTileInfos(const TilesetData& tileset) const;
+
+    std::span<const PropertyData> getProperties(PropertyRange range) const;
+    std::span<const PropertyData> getMapProperties() const { return getProperties(map_properties_); }
+    // nullptr if the range has no property of that name
+    const PropertyData* findProperty(PropertyRange range, std::string_view name) const;
+    std::string_view getString(StringRef ref) const;
+
+    // heap bytes held by the arrays
+    size_t getMemoryUsage() const;
+
+    // building, used by the loaders
+    void setSourcePath(std::string_view path) { source_path_ = std::string(path); }
+    void setMapSize(const glm::ivec2& map_size, const glm::ivec2& tile_size);
+    StringRef addString(std::string_view text);
+    uint32_t getPropertyCount() const { return static_cast<uint32_t>(properties_.size()); }
+    void addProperty(const PropertyData& property) { properties_.push_back(property); }
+    void setMapProperties(PropertyRange range) { map_properties_ = range; }
+    void addLayer(const LayerData& layer) { layers_.push_back(layer); }
+    uint32_t getTileCount() const { return static_cast<uint32_t>(tiles_.size()); }
+    std::vector<uint16_t>& getTileStorage() { return tiles_; }
+    uint32_t getParallaxLayerCount() const { return static_cast<uint32_t>(parallax_layers_.size()); }
+    void addParallaxLayer(const ParallaxLayer& layer) { parallax_layers_.push_back(layer); }
+    uint32_t getObjectCount() const { return static_cast<uint32_t>(object_ids_.size()); }
+    void addObject(const ObjectData& object);
+    void addTileset(const TilesetData& tileset) { tilesets_.push_back(tileset); }
+    uint32_t getTileInfoCount() const { return static_cast<uint32_t>(tile_infos_.size()); }
+    void addTileInfo(const TileInfo& info) { tile_infos_.push_back(info); }
+    // drops build-time bookkeeping once the level is complete
+    void finish();
+
+private:
+    ObjectArrays sliceObjects(uint32_t first, uint32_t count) const;
+};
+
+} // namespace engine::level
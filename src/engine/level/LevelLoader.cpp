@@ -0,0 +1,905 @@
+#include "LevelLoader.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+
+#include "engine/utils/MappedFile.hpp"
+
+namespace engine::level
+{
+
+namespace
+{
+
+namespace fs = std::filesystem;
+
+// One value event of the parser. text points into the parser's buffer and is only valid during the event.
+struct Scalar
+{
+    enum class Kind
+    {
+        NONE,
+        BOOL,
+        INT,
+        FLOAT,
+        STRING,
+    };
+
+    Kind kind = Kind::NONE;
+    bool boolean = false;
+    int64_t integer = 0;
+    double number = 0.0;
+    std::string_view text;
+
+    int64_t asInt() const
+    {
+        switch (kind)
+        {
+        case Kind::BOOL: return boolean ? 1 : 0;
+        case Kind::INT: return integer;
+        case Kind::FLOAT: return static_cast<int64_t>(number);
+        default: return 0;
+        }
+    }
+    bool asBool() const { return asInt() != 0; }
+    uint32_t asUint() const { return static_cast<uint32_t>(asInt()); }
+    double asDouble() const { return kind == Kind::FLOAT ? number : static_cast<double>(asInt()); }
+    float asFloat() const { return static_cast<float>(asDouble()); }
+    std::string_view asText() const { return kind == Kind::STRING ? text : std::string_view(); }
+};
+
+std::string toJson(const Scalar& value)
+{
+    switch (value.kind)
+    {
+    case Scalar::Kind::BOOL: return value.boolean ? "true" : "false";
+    case Scalar::Kind::INT: return fmt::format("{}", value.integer);
+    case Scalar::Kind::FLOAT: return fmt::format("{}", value.number);
+    case Scalar::Kind::STRING: return nlohmann::json(std::string(value.text)).dump();
+    default: return "null";
+    }
+}
+
+// Writes the events of one subtree back out as JSON text, used for class property values.
+class JsonWriter final
+{
+private:
+    std::string out_;
+    std::vector<bool> first_; // per open object/array: nothing written into it yet
+    bool after_key_ = false;
+
+public:
+    void clear()
+    {
+        out_.clear();
+        first_.clear();
+        after_key_ = false;
+    }
+    const std::string& getText() const { return out_; }
+
+    void key(std::string_view key)
+    {
+        separate();
+        out_ += nlohmann::json(std::string(key)).dump();
+        out_ += ':';
+        after_key_ = true;
+    }
+    void open(char bracket)
+    {
+        separate();
+        out_ += bracket;
+        first_.push_back(true);
+    }
+    void close(char bracket)
+    {
+        out_ += bracket;
+        first_.pop_back();
+    }
+    void scalar(const Scalar& value)
+    {
+        separate();
+        out_ += toJson(value);
+    }
+
+private:
+    void separate()
+    {
+        if (after_key_)
+        {
+            after_key_ = false;
+            return;
+        }
+        if (!first_.empty())
+        {
+            if (!first_.back())
+            {
+                out_ += ',';
+            }
+            first_.back() = false;
+        }
+    }
+};
+
+enum class Scope
+{
+    MAP,
+    LAYERS,
+    LAYER,
+    TILE_DATA,
+    OBJECTS,
+    OBJECT,
+    PROPERTIES,
+    PROPERTY,
+    TILESETS,
+    TILESET,
+    TILES,
+    TILE,
+};
+
+// A layer still being read; groups stay open while their children are read.
+struct LayerState
+{
+    LayerData data;
+    std::string type;
+    ParallaxLayer image;
+    // groups: index of their first descendant in the pending layers
+    size_t first_child = 0;
+};
+
+struct TilesetState
+{
+    TilesetData data;
+    std::string source;
+    // gids are local ids until the tileset is closed, firstgid may come after the tiles
+    std::vector<TileInfo> tiles;
+};
+
+struct PropertyState
+{
+    PropertyData data;
+    std::string type = "string";
+    Scalar value;
+    std::string text; // string and class values, value.text is not kept across events
+};
+
+class TiledSaxHandler final : public nlohmann::json_sax<nlohmann::json>
+{
+private:
+    struct Frame
+    {
+        Scope scope;
+        std::string key; // objects: the key of the value being read
+        uint32_t first = 0;
+    };
+
+    LevelData& level_;
+    const fs::path& root_;
+    fs::path base_dir_; // relative paths in the file are relative to this
+    Scope root_scope_;
+    bool complete_ = false;
+    std::string error_;
+
+    std::vector<Frame> stack_;
+    // depth inside a subtree nothing is read from
+    int skip_depth_ = 0;
+    // depth inside a class property value, which is kept as JSON text
+    int capture_depth_ = 0;
+    JsonWriter capture_;
+
+    glm::ivec2 map_size_ = {0, 0};
+    glm::ivec2 tile_size_ = {0, 0};
+    std::vector<LayerState> open_layers_;
+    // groups adjust their children when they close, so layers are only added once the map is complete
+    std::vector<LayerData> layers_;
+    std::vector<ParallaxLayer> parallax_layers_;
+
+    TilesetState tileset_;
+    TileInfo tile_;
+    ObjectData object_;
+    StringRef object_class_;
+    PropertyState property_;
+
+public:
+    TiledSaxHandler(LevelData& level, const fs::path& root, fs::path base_dir, Scope root_scope)
+        : level_(level)
+        , root_(root)
+        , base_dir_(std::move(base_dir))
+        , root_scope_(root_scope)
+    {
+    }
+
+    bool isComplete() const { return complete_; }
+    const std::string& getError() const { return error_; }
+    TilesetState& getTileset() { return tileset_; }
+
+    // relative to the project root, so the engine can prefix SOURCE_DIR
+    std::string resolve(std::string_view path) const
+    {
+        return (base_dir_ / fs::path(path)).lexically_normal().lexically_relative(root_).generic_string();
+    }
+
+    bool null() override { return onScalar({}); }
+    bool boolean(bool value) override
+    {
+        Scalar scalar;
+        scalar.kind = Scalar::Kind::BOOL;
+        scalar.boolean = value;
+        return onScalar(scalar);
+    }
+    bool number_integer(number_integer_t value) override
+    {
+        Scalar scalar;
+        scalar.kind = Scalar::Kind::INT;
+        scalar.integer = value;
+        return onScalar(scalar);
+    }
+    bool number_unsigned(number_unsigned_t value) override
+    {
+        Scalar scalar;
+        scalar.kind = Scalar::Kind::INT;
+        scalar.integer = static_cast<int64_t>(value);
+        return onScalar(scalar);
+    }
+    bool number_float(number_float_t value, const string_t&) override
+    {
+        Scalar scalar;
+        scalar.kind = Scalar::Kind::FLOAT;
+        scalar.number = value;
+        return onScalar(scalar);
+    }
+    bool string(string_t& value) override
+    {
+        Scalar scalar;
+        scalar.kind = Scalar::Kind::STRING;
+        scalar.text = value;
+        return onScalar(scalar);
+    }
+    bool binary(binary_t&) override { return true; }
+
+    bool key(string_t& key) override
+    {
+        if (skip_depth_ > 0)
+            return true;
+        if (capture_depth_ > 0)
+        {
+            capture_.key(key);
+            return true;
+        }
+        stack_.back().key = key;
+        return true;
+    }
+
+    bool start_object(std::size_t) override
+    {
+        if (skip_depth_ > 0)
+        {
+            ++skip_depth_;
+            return true;
+        }
+        if (capture_depth_ > 0)
+        {
+            ++capture_depth_;
+            capture_.open('{');
+            return true;
+        }
+        if (stack_.empty())
+        {
+            push(root_scope_);
+            return true;
+        }
+
+        const Frame& parent = stack_.back();
+        switch (parent.scope)
+        {
+        case Scope::LAYERS:
+            openLayer();
+            push(Scope::LAYER);
+            return true;
+        case Scope::OBJECTS:
+            object_ = {};
+            object_class_ = {};
+            push(Scope::OBJECT);
+            return true;
+        case Scope::PROPERTIES:
+            property_ = {};
+            push(Scope::PROPERTY);
+            return true;
+        case Scope::TILESETS:
+            tileset_ = {};
+            tileset_.data.first_gid = 1;
+            push(Scope::TILESET);
+            return true;
+        case Scope::TILES:
+            tile_ = {};
+            push(Scope::TILE);
+            return true;
+        case Scope::PROPERTY:
+            if (parent.key == "value")
+                return startCapture('{');
+            break;
+        default: break;
+        }
+        return skip();
+    }
+
+    bool end_object() override
+    {
+        if (skip_depth_ > 0)
+        {
+            --skip_depth_;
+            return true;
+        }
+        if (capture_depth_ > 0)
+        {
+            capture_.close('}');
+            return --capture_depth_ > 0 || endCapture();
+        }
+
+        Scope scope = stack_.back().scope;
+        stack_.pop_back();
+        switch (scope)
+        {
+        case Scope::MAP: return closeMap();
+        case Scope::LAYER: return closeLayer();
+        case Scope::OBJECT:
+            if (object_.type.length == 0)
+            {
+                object_.type = object_class_;
+            }
+            level_.addObject(object_);
+            return true;
+        case Scope::PROPERTY: return closeProperty();
+        case Scope::TILESET:
+            // the root of a .tsj, the map that references it finishes the tileset
+            if (stack_.empty())
+            {
+                complete_ = true;
+                return true;
+            }
+            return closeTileset();
+        case Scope::TILE:
+            tileset_.tiles.push_back(tile_);
+            return true;
+        default: return true;
+        }
+    }
+
+    bool start_array(std::size_t) override
+    {
+        if (skip_depth_ > 0)
+        {
+            ++skip_depth_;
+            return true;
+        }
+        if (capture_depth_ > 0)
+        {
+            ++capture_depth_;
+            capture_.open('[');
+            return true;
+        }
+        if (stack_.empty())
+            return fail("the top level is not an object");
+
+        const Frame& parent = stack_.back();
+        const std::string& key = parent.key;
+        switch (parent.scope)
+        {
+        case Scope::MAP:
+            if (key == "layers")
+                return push(Scope::LAYERS);
+            if (key == "tilesets")
+                return push(Scope::TILESETS);
+            if (key == "properties")
+                return push(Scope::PROPERTIES, level_.getPropertyCount());
+            break;
+        case Scope::LAYER:
+            if (key == "layers")
+                return push(Scope::LAYERS);
+            if (key == "data")
+            {
+                open_layers_.back().data.first = level_.getTileCount();
+                return push(Scope::TILE_DATA);
+            }
+            if (key == "objects")
+            {
+                open_layers_.back().data.first = level_.getObjectCount();
+                return push(Scope::OBJECTS);
+            }
+            if (key == "properties")
+                return push(Scope::PROPERTIES, level_.getPropertyCount());
+            break;
+        case Scope::OBJECT:
+        case Scope::TILE:
+            if (key == "properties")
+                return push(Scope::PROPERTIES, level_.getPropertyCount());
+            break;
+        case Scope::TILESET:
+            if (key == "tiles")
+                return push(Scope::TILES);
+            break;
+        case Scope::PROPERTY:
+            if (key == "value")
+                return startCapture('[');
+            break;
+        default: break;
+        }
+        return skip();
+    }
+
+    bool end_array() override
+    {
+        if (skip_depth_ > 0)
+        {
+            --skip_depth_;
+            return true;
+        }
+        if (capture_depth_ > 0)
+        {
+            capture_.close(']');
+            return --capture_depth_ > 0 || endCapture();
+        }
+
+        Frame frame = std::move(stack_.back());
+        stack_.pop_back();
+        switch (frame.scope)
+        {
+        case Scope::TILE_DATA:
+        {
+            LayerData& layer = open_layers_.back().data;
+            layer.count = level_.getTileCount() - layer.first;
+            return true;
+        }
+        case Scope::OBJECTS:
+        {
+            LayerData& layer = open_layers_.back().data;
+            layer.count = level_.getObjectCount() - layer.first;
+            return true;
+        }
+        case Scope::PROPERTIES:
+        {
+            PropertyRange range{frame.first, level_.getPropertyCount() - frame.first};
+            switch (stack_.back().scope)
+            {
+            case Scope::MAP: level_.setMapProperties(range); break;
+            case Scope::LAYER: open_layers_.back().data.properties = range; break;
+            case Scope::OBJECT: object_.properties = range; break;
+            case Scope::TILE: tile_.properties = range; break;
+            default: break;
+            }
+            return true;
+        }
+        default: return true;
+        }
+    }
+
+    bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception& ex) override { return fail(ex.what()); }
+
+private:
+    bool fail(std::string message)
+    {
+        error_ = std::move(message);
+        return false;
+    }
+
+    bool push(Scope scope, uint32_t first = 0)
+    {
+        stack_.push_back({scope, {}, first});
+        return true;
+    }
+
+    bool skip()
+    {
+        skip_depth_ = 1;
+        return true;
+    }
+
+    bool startCapture(char bracket)
+    {
+        capture_.clear();
+        capture_.open(bracket);
+        capture_depth_ = 1;
+        return true;
+    }
+
+    bool endCapture()
+    {
+        property_.text = capture_.getText();
+        property_.value = {};
+        property_.value.kind = Scalar::Kind::STRING;
+        return true;
+    }
+
+    bool onScalar(const Scalar& value)
+    {
+        if (skip_depth_ > 0)
+            return true;
+        if (capture_depth_ > 0)
+        {
+            capture_.scalar(value);
+            return true;
+        }
+        if (stack_.empty())
+            return fail("the top level is not an object");
+
+        const Frame& frame = stack_.back();
+        switch (frame.scope)
+        {
+        case Scope::TILE_DATA: return addTile(value);
+        case Scope::MAP: return onMapField(frame.key, value);
+        case Scope::LAYER: return onLayerField(frame.key, value);
+        case Scope::OBJECT: onObjectField(frame.key, value); return true;
+        case Scope::PROPERTY: onPropertyField(frame.key, value); return true;
+        case Scope::TILESET: onTilesetField(frame.key, value); return true;
+        case Scope::TILE: onTileField(frame.key, value); return true;
+        default: return true;
+        }
+    }
+
+    bool addTile(const Scalar& value)
+    {
+        if (value.kind != Scalar::Kind::INT)
+            return fail("tile data holds something other than gids");
+        uint16_t packed = 0;
+        if (!packTileGid(static_cast<uint32_t>(value.integer), packed))
+            return fail(fmt::format("gid {} does not fit in 16 bit tiles (at most {})", static_cast<uint32_t>(value.integer) & 0x0FFFFFFFu, LEVEL_TILE_GID_MASK));
+        level_.getTileStorage().push_back(packed);
+        return true;
+    }
+
+    bool onMapField(std::string_view key, const Scalar& value)
+    {
+        if (key == "width")
+            map_size_.x = static_cast<int>(value.asInt());
+        else if (key == "height")
+            map_size_.y = static_cast<int>(value.asInt());
+        else if (key == "tilewidth")
+            tile_size_.x = static_cast<int>(value.asInt());
+        else if (key == "tileheight")
+            tile_size_.y = static_cast<int>(value.asInt());
+        else if (key == "infinite" && value.asBool())
+            return fail("infinite maps are not supported");
+        else if (key == "orientation" && value.asText() != "orthogonal")
+            return fail(fmt::format("{} maps are not supported", value.asText()));
+        return true;
+    }
+
+    void openLayer()
+    {
+        LayerState state;
+        state.first_child = layers_.size();
+        open_layers_.push_back(std::move(state));
+    }
+
+    bool onLayerField(std::string_view key, const Scalar& value)
+    {
+        LayerState& state = open_layers_.back();
+        LayerData& layer = state.data;
+        if (key == "name")
+            layer.name = level_.addString(value.asText());
+        else if (key == "type")
+            state.type = std::string(value.asText());
+        else if (key == "visible")
+            layer.visible = value.asBool() ? 1 : 0;
+        else if (key == "opacity")
+            layer.opacity = value.asFloat();
+        else if (key == "offsetx")
+            layer.offset.x = value.asFloat();
+        else if (key == "offsety")
+            layer.offset.y = value.asFloat();
+        else if (key == "parallaxx")
+            layer.parallax.x = value.asFloat();
+        else if (key == "parallaxy")
+            layer.parallax.y = value.asFloat();
+        else if (key == "width")
+            layer.width = value.asUint();
+        else if (key == "height")
+            layer.height = value.asUint();
+        else if (key == "image")
+            state.image.image = value.asText().empty() ? StringRef{} : level_.addString(resolve(value.asText()));
+        else if (key == "imagewidth")
+            state.image.image_size.x = static_cast<int>(value.asInt());
+        else if (key == "imageheight")
+            state.image.image_size.y = static_cast<int>(value.asInt());
+        else if (key == "repeatx")
+            state.image.repeat_x = value.asBool() ? 1 : 0;
+        else if (key == "repeaty")
+            state.image.repeat_y = value.asBool() ? 1 : 0;
+        else if ((key == "encoding" && value.asText() != "csv") || (key == "compression" && !value.asText().empty()) || key == "data")
+            return fail("encoded tile data, save the map with CSV tile layer format");
+        return true;
+    }
+
+    bool closeLayer()
+    {
+        LayerState state = std::move(open_layers_.back());
+        open_layers_.pop_back();
+        LayerData& layer = state.data;
+
+        if (state.type == "group")
+        {
+            for (size_t i = state.first_child; i < layers_.size(); ++i)
+            {
+                LayerData& child = layers_[i];
+                child.offset += layer.offset;
+                child.parallax = child.parallax * layer.parallax;
+                child.opacity *= layer.opacity;
+                child.visible = child.visible && layer.visible ? 1 : 0;
+            }
+            return true;
+        }
+
+        if (state.type == "tilelayer")
+        {
+            layer.kind = LayerKind::TILE;
+            if (layer.count != layer.width * layer.height)
+                return fail(fmt::format("tile layer {} has {} tiles instead of {}x{}", level_.getString(layer.name), layer.count, layer.width, layer.height));
+        }
+        else if (state.type == "imagelayer")
+        {
+            layer.kind = LayerKind::IMAGE;
+            layer.first = static_cast<uint32_t>(parallax_layers_.size());
+            layer.count = 1;
+            layer.width = static_cast<uint32_t>(state.image.image_size.x);
+            layer.height = static_cast<uint32_t>(state.image.image_size.y);
+            parallax_layers_.push_back(state.image);
+        }
+        else if (state.type == "objectgroup")
+        {
+            layer.kind = LayerKind::OBJECT;
+        }
+        else
+        {
+            spdlog::warn("LevelLoader: skipping layer {} of unknown type {}", level_.getString(layer.name), state.type);
+            return true;
+        }
+        layers_.push_back(layer);
+        return true;
+    }
+
+    bool closeMap()
+    {
+        level_.setMapSize(map_size_, tile_size_);
+        for (const auto& layer : layers_)
+        {
+            // the flattened offset and parallax are what drawParallax takes
+            if (layer.kind == LayerKind::IMAGE)
+            {
+                parallax_layers_[layer.first].position = layer.offset;
+                parallax_layers_[layer.first].scroll_factor = layer.parallax;
+            }
+            level_.addLayer(layer);
+        }
+        for (const auto& parallax : parallax_layers_)
+        {
+            level_.addParallaxLayer(parallax);
+        }
+        complete_ = true;
+        return true;
+    }
+
+    void onObjectField(std::string_view key, const Scalar& value)
+    {
+        if (key == "id")
+            object_.id = value.asUint();
+        else if (key == "gid")
+            object_.gid = value.asUint();
+        else if (key == "name")
+            object_.name = level_.addString(value.asText());
+        else if (key == "type")
+            object_.type = level_.addString(value.asText());
+        else if (key == "class")
+            object_class_ = level_.addString(value.asText());
+        else if (key == "x")
+            object_.position.x = value.asFloat();
+        else if (key == "y")
+            object_.position.y = value.asFloat();
+        else if (key == "width")
+            object_.size.x = value.asFloat();
+        else if (key == "height")
+            object_.size.y = value.asFloat();
+        else if (key == "rotation")
+            object_.rotation = value.asFloat();
+        else if (key == "visible")
+            object_.visible = value.asBool() ? 1 : 0;
+    }
+
+    void onPropertyField(std::string_view key, const Scalar& value)
+    {
+        if (key == "name")
+            property_.data.name = level_.addString(value.asText());
+        else if (key == "type")
+            property_.type = std::string(value.asText());
+        else if (key == "value")
+        {
+            property_.value = value;
+            property_.value.text = {};
+            property_.text = value.kind == Scalar::Kind::STRING ? std::string(value.text) : toJson(value);
+        }
+    }
+
+    bool closeProperty()
+    {
+        PropertyData& property = property_.data;
+        const Scalar& value = property_.value;
+        const std::string& type = property_.type;
+        if (type == "bool")
+        {
+            property.type = PropertyType::BOOL;
+            property.int_value = value.asBool() ? 1 : 0;
+        }
+        else if (type == "int")
+        {
+            property.type = PropertyType::INT;
+            property.int_value = value.asInt();
+            property.float_value = static_cast<double>(property.int_value);
+        }
+        else if (type == "float")
+        {
+            property.type = PropertyType::FLOAT;
+            property.float_value = value.asDouble();
+        }
+        else if (type == "color")
+        {
+            // "#AARRGGBB" or "#RRGGBB", empty when unset
+            property.type = PropertyType::COLOR;
+            const std::string& hex = property_.text;
+            if (value.kind == Scalar::Kind::STRING && hex.size() > 1)
+            {
+                property.int_value = static_cast<int64_t>(std::strtoul(hex.c_str() + 1, nullptr, 16));
+                if (hex.size() == 7)
+                {
+                    property.int_value |= 0xFF000000ll;
+                }
+            }
+        }
+        else if (type == "file")
+        {
+            property.type = PropertyType::FILE;
+            if (value.kind == Scalar::Kind::STRING && !property_.text.empty())
+            {
+                property.string_value = level_.addString(resolve(property_.text));
+            }
+        }
+        else if (type == "object")
+        {
+            property.type = PropertyType::OBJECT;
+            property.int_value = value.asInt();
+        }
+        else if (type == "class")
+        {
+            property.type = PropertyType::CLASS;
+            property.string_value = level_.addString(property_.text);
+        }
+        else
+        {
+            property.type = PropertyType::STRING;
+            property.string_value = level_.addString(property_.text);
+        }
+        level_.addProperty(property);
+        return true;
+    }
+
+    void onTilesetField(std::string_view key, const Scalar& value)
+    {
+        TilesetData& data = tileset_.data;
+        if (key == "firstgid")
+            data.first_gid = value.asUint();
+        else if (key == "source")
+            tileset_.source = std::string(value.asText());
+        else if (key == "name")
+            data.name = level_.addString(value.asText());
+        else if (key == "tilecount")
+            data.tile_count = value.asUint();
+        else if (key == "columns")
+            data.columns = value.asUint();
+        else if (key == "margin")
+            data.margin = value.asUint();
+        else if (key == "spacing")
+            data.spacing = value.asUint();
+        else if (key == "tilewidth")
+            data.tile_size.x = static_cast<int>(value.asInt());
+        else if (key == "tileheight")
+            data.tile_size.y = static_cast<int>(value.asInt());
+        else if (key == "image")
+            data.image = level_.addString(resolve(value.asText()));
+        else if (key == "imagewidth")
+            data.image_size.x = static_cast<int>(value.asInt());
+        else if (key == "imageheight")
+            data.image_size.y = static_cast<int>(value.asInt());
+    }
+
+    void onTileField(std::string_view key, const Scalar& value)
+    {
+        if (key == "id")
+            tile_.gid = value.asUint();
+        else if (key == "image")
+            tile_.image = level_.addString(resolve(value.asText()));
+        else if (key == "imagewidth")
+            tile_.image_size.x = static_cast<int>(value.asInt());
+        else if (key == "imageheight")
+            tile_.image_size.y = static_cast<int>(value.asInt());
+    }
+
+    bool closeTileset();
+};
+
+bool parseFile(const fs::path& path, TiledSaxHandler& handler)
+{
+    engine::utils::MappedFile file;
+    if (!file.open(path.string()))
+        return false;
+
+    const char* begin = reinterpret_cast<const char*>(file.getData());
+    if (!nlohmann::json::sax_parse(begin, begin + file.getSize(), &handler) || !handler.isComplete())
+    {
+        spdlog::error("LevelLoader: failed to read {}: {}", path.string(), handler.getError().empty() ? "unexpected structure" : handler.getError());
+        return false;
+    }
+    return true;
+}
+
+bool TiledSaxHandler::closeTileset()
+{
+    if (!tileset_.source.empty())
+    {
+        // an external tileset, streamed the same way; its paths are relative to the .tsj
+        const fs::path path = (base_dir_ / fs::path(tileset_.source)).lexically_normal();
+        TiledSaxHandler handler(level_, root_, path.parent_path(), Scope::TILESET);
+        if (!parseFile(path, handler))
+            return fail(fmt::format("cannot load tileset {}", tileset_.source));
+
+        const uint32_t first_gid = tileset_.data.first_gid;
+        tileset_ = std::move(handler.getTileset());
+        tileset_.data.first_gid = first_gid;
+    }
+
+    TilesetData& data = tileset_.data;
+    data.first_tile_info = level_.getTileInfoCount();
+    data.tile_info_count = static_cast<uint32_t>(tileset_.tiles.size());
+    for (TileInfo info : tileset_.tiles)
+    {
+        info.gid += data.first_gid;
+        level_.addTileInfo(info);
+    }
+    level_.addTileset(data);
+    return true;
+}
+
+} // namespace
+
+LevelLoader::LevelLoader(std::string_view root)
+    : root_(fs::absolute(fs::path(root)).lexically_normal())
+{
+    if (!root_.has_filename())
+    {
+        root_ = root_.parent_path();
+    }
+}
+
+bool LevelLoader::load(std::string_view map_path, LevelData& level) const
+{
+    auto start = std::chrono::steady_clock::now();
+    level.clear();
+
+    const fs::path path = fs::absolute(fs::path(map_path)).lexically_normal();
+    TiledSaxHandler handler(level, root_, path.parent_path(), Scope::MAP);
+    level.setSourcePath(handler.resolve(path.filename().string()));
+    if (!parseFile(path, handler))
+    {
+        level.clear();
+        return false;
+    }
+    level.finish();
+
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    spdlog::info("LevelLoader: loaded {} in {} us ({} layers, {} tiles, {} objects, {} KB)", map_path, elapsed.count(), level.getLayers().size(), level.getTileCount(), level.getObjectCount(), level.getMemoryUsage() / 1024);
+    return true;
+}
+
+} // namespace engine::level
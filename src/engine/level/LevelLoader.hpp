@@ -0,0 +1,33 @@
+#pragma once
+
+#include <filesystem>
+#include <string_view>
+
+#include "engine/level/LevelData.hpp"
+
+namespace engine::level
+{
+
+// Reads Tiled .tmj maps, and the .tsj tilesets they reference, straight into LevelData through nlohmann's SAX
+// interface: tile data goes from the parser into the packed tile array as it is read, no JSON document is built.
+// Group layers are flattened the same way LevelData describes. Only orthogonal, finite maps with CSV tile data are
+// supported. Paths are stored relative to the project root.
+class LevelLoader final
+{
+private:
+    std::filesystem::path root_;
+
+public:
+    // root: the directory level paths are made relative to, usually SOURCE_DIR
+    explicit LevelLoader(std::string_view root);
+
+    LevelLoader(const LevelLoader&) = delete;
+    LevelLoader& operator=(const LevelLoader&) = delete;
+    LevelLoader(LevelLoader&&) = delete;
+    LevelLoader& operator=(LevelLoader&&) = delete;
+
+    // logs and returns false on failure, the level is left cleared then
+    bool load(std::string_view map_path, LevelData& level) const;
+};
+
+} // namespace engine::level
@@ -64,6 +64,11 @@ const std::optional<engine::utils::Rect>& Camera::getLimitBounds() const
     return limit_bounds_;
 }
 
+engine::utils::Rect Camera::getViewRect(float margin) const
+{
+    return engine::utils::Rect{position_ - glm::vec2(margin, margin), viewport_size_ + glm::vec2(margin * 2.0f, margin * 2.0f)};
+}
+
 void Camera::clampPosition()
 {
     if (limit_bounds_.has_value() && limit_bounds_->size.x > 0 && limit_bounds_->size.y > 0)
@@ -34,6 +34,8 @@ public:
     const glm::vec2& getViewportSize() const;
     const glm::vec2& getPosition() const;
     const std::optional<engine::utils::Rect>& getLimitBounds() const;
+    // world-space rectangle seen by the camera, grown by margin on every side
+    engine::utils::Rect getViewRect(float margin = 0.0f) const;
 
 private:
     void clampPosition();
@@ -0,0 +1,138 @@
+#include "RenderQueue.hpp"
+
+#include <algorithm>
+#include <cstddef>
+
+#include <SDL3/SDL_render.h>
+
+namespace engine::render
+{
+
+namespace
+{
+constexpr int LAYER_SHIFT = 56;
+constexpr int DEPTH_SHIFT = 32;
+constexpr uint64_t DEPTH_MASK = 0xFFFFFF;
+constexpr uint64_t TEXTURE_MASK = 0xFFFF;
+constexpr uint64_t BLEND_MASK = 0xF;
+
+uint64_t textureBits(const SDL_Texture* texture)
+{
+    // fibonacci hash of the pointer, equal textures always land in the same bucket
+    auto value = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(texture));
+    return ((value * 0x9E3779B97F4A7C15ull) >> 48) & TEXTURE_MASK;
+}
+
+uint64_t blendBits(SDL_Texture* texture)
+{
+    SDL_BlendMode mode = SDL_BLENDMODE_NONE;
+    if (texture == nullptr || !SDL_GetTextureBlendMode(texture, &mode))
+        return BLEND_MASK;
+
+    switch (mode)
+    {
+    case SDL_BLENDMODE_NONE:
+        return 0;
+    case SDL_BLENDMODE_BLEND:
+        return 1;
+    case SDL_BLENDMODE_ADD:
+        return 2;
+    case SDL_BLENDMODE_MOD:
+        return 3;
+    default:
+        return BLEND_MASK;
+    }
+}
+
+uint64_t depthBits(const SDL_FRect& dest_rect)
+{
+    // bottom edge in quarter pixels, biased so slightly negative positions still sort
+    constexpr float BIAS = static_cast<float>(1 << 22);
+    float depth = (dest_rect.y + dest_rect.h) * 4.0f + BIAS;
+    return static_cast<uint64_t>(std::clamp(depth, 0.0f, static_cast<float>(DEPTH_MASK)));
+}
+} // namespace
+
+RenderQueue::RenderQueue()
+{
+    layer_modes_.fill(LayerSortMode::STABLE);
+}
+
+void RenderQueue::push(uint8_t layer, RenderCommand command)
+{
+    command.key = makeKey(layer, command);
+    commands_.push_back(command);
+}
+
+const std::vector<RenderCommand>& RenderQueue::sort()
+{
+    entries_.clear();
+    for (size_t i = 0; i < commands_.size(); ++i)
+    {
+        entries_.push_back({commands_[i].key, static_cast<uint32_t>(i)});
+    }
+
+    radixSort();
+
+    sorted_.clear();
+    for (const auto& entry : entries_)
+    {
+        sorted_.push_back(commands_[entry.index]);
+    }
+    return sorted_;
+}
+
+void RenderQueue::clear()
+{
+    commands_.clear();
+    entries_.clear();
+    sorted_.clear();
+}
+
+uint64_t RenderQueue::makeKey(uint8_t layer, const RenderCommand& command) const
+{
+    uint64_t key = static_cast<uint64_t>(layer) << LAYER_SHIFT;
+    switch (layer_modes_[layer])
+    {
+    case LayerSortMode::STABLE:
+        break;
+    case LayerSortMode::TEXTURE:
+        key |= textureBits(command.texture) << 40 | blendBits(command.texture) << 36;
+        break;
+    case LayerSortMode::Y_DEPTH:
+        key |= depthBits(command.dest_rect) << DEPTH_SHIFT | textureBits(command.texture) << 16 | blendBits(command.texture) << 12;
+        break;
+    }
+    return key;
+}
+
+void RenderQueue::radixSort()
+{
+    // LSD radix sort, one byte per pass; passes where every key has the same byte are skipped
+    scratch_.resize(entries_.size());
+    for (int shift = 0; shift < 64; shift += 8)
+    {
+        size_t counts[256] = {};
+        for (const auto& entry : entries_)
+        {
+            ++counts[(entry.key >> shift) & 0xFF];
+        }
+        if (entries_.empty() || counts[(entries_.front().key >> shift) & 0xFF] == entries_.size())
+            continue;
+
+        size_t offset = 0;
+        for (auto& count : counts)
+        {
+            size_t current = count;
+            count = offset;
+            offset += current;
+        }
+        for (const auto& entry : entries_)
+        {
+            scratch_[counts[(entry.key >> shift) & 0xFF]++] = entry;
+        }
+        entries_.swap(scratch_);
+    }
+}
+
+} // namespace engine::render
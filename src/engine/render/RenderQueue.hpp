@@ -0,0 +1,90 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include <SDL3/SDL_rect.h>
+#include <glm/vec2.hpp>
+
+struct SDL_Texture;
+struct TTF_Text;
+
+namespace engine::render
+{
+
+enum class LayerSortMode : uint8_t
+{
+    STABLE,  // submission (painter) order
+    TEXTURE, // group by texture and blend mode
+    Y_DEPTH, // back to front by the bottom edge on screen, then texture and blend mode
+};
+
+enum class RenderCommandType : uint8_t
+{
+    QUAD,
+    PARALLAX,
+    TEXT,
+};
+
+// Compact POD draw, everything is resolved when it is pushed so the flush never looks anything up.
+struct RenderCommand
+{
+    uint64_t key = 0;
+    SDL_Texture* texture = nullptr;
+    TTF_Text* text = nullptr; // text only, drawn at dest_rect's position
+    glm::vec2 texture_size = {0.0f, 0.0f};
+    SDL_FRect src_rect = {0.0f, 0.0f, 0.0f, 0.0f};
+    SDL_FRect dest_rect = {0.0f, 0.0f, 0.0f, 0.0f};
+    glm::vec2 repeats = {1.0f, 1.0f}; // parallax only
+    glm::vec2 scale = {1.0f, 1.0f};   // parallax only
+    float angle = 0.0f;
+    RenderCommandType type = RenderCommandType::QUAD;
+    bool is_flipped = false;
+    bool wrap_sampler = false; // parallax only, texture can be repeated through UVs
+};
+
+// Deferred draw list sorted by a packed 64-bit key: layer | depth | texture | blend mode.
+class RenderQueue final
+{
+private:
+    struct SortEntry
+    {
+        uint64_t key;
+        uint32_t index;
+    };
+
+    std::array<LayerSortMode, 256> layer_modes_;
+    // arena: these only ever grow, clear() keeps their capacity
+    std::vector<RenderCommand> commands_;
+    std::vector<SortEntry> entries_;
+    std::vector<SortEntry> scratch_;
+    std::vector<RenderCommand> sorted_;
+
+public:
+    RenderQueue();
+
+    RenderQueue(const RenderQueue&) = delete;
+    RenderQueue& operator=(const RenderQueue&) = delete;
+    RenderQueue(RenderQueue&&) = delete;
+    RenderQueue& operator=(RenderQueue&&) = delete;
+
+    void setLayerSortMode(uint8_t layer, LayerSortMode mode) { layer_modes_[layer] = mode; }
+    LayerSortMode getLayerSortMode(uint8_t layer) const { return layer_modes_[layer]; }
+
+    // fills in command.key from the layer and the command's texture and position
+    void push(uint8_t layer, RenderCommand command);
+
+    // radix sorts the pending commands, equal keys keep submission order
+    const std::vector<RenderCommand>& sort();
+    void clear();
+
+    bool empty() const { return commands_.empty(); }
+    size_t size() const { return commands_.size(); }
+
+private:
+    uint64_t makeKey(uint8_t layer, const RenderCommand& command) const;
+    void radixSort();
+};
+
+} // namespace engine::render
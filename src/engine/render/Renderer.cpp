@@ -1,14 +1,19 @@
 #include "Renderer.hpp"
 
+#include <cmath>
 #include <cstddef>
 #include <stdexcept>
+#include <utility>
 
 #include <spdlog/spdlog.h>
 
 #include <SDL3/SDL_error.h>
+#include <SDL3/SDL_properties.h>
 #include <SDL3/SDL_rect.h>
 #include <SDL3/SDL_render.h>
 #include <SDL3/SDL_surface.h>
+#include <SDL3/SDL_timer.h>
+#include <SDL3_ttf/SDL_ttf.h>
 
 #include "engine/render/Camera.hpp"
 #include "engine/render/Sprite.hpp"
@@ -33,19 +38,17 @@ Renderer::Renderer(SDL_Renderer* renderer, engine::resource::ResourceManager* re
     }
 
     setDrawColor(0, 0, 0, 255);
-    spdlog::trace("Renderer constructed successfully");
+    texture_wrapping_supported_ = SDL_GetBooleanProperty(SDL_GetRendererProperties(renderer_), SDL_PROP_RENDERER_TEXTURE_WRAPPING_BOOLEAN, false);
+    spdlog::trace("Renderer constructed successfully, texture wrapping {}", texture_wrapping_supported_ ? "supported" : "not supported");
 }
 
 void Renderer::drawSprite(const Camera& camera, const Sprite& sprite, const glm::vec2& position, const glm::vec2& scale, float angle)
 {
-    auto texture = resource_manager_->getTexture(sprite.getTextureId());
-    if (!texture)
-    {
-        spdlog::error("getTexture {} failed", sprite.getTextureId());
+    const auto* region = resolveTexture(sprite);
+    if (!region)
         return;
-    }
 
-    auto src_rect = getSpritesRect(sprite);
+    auto src_rect = getSpritesRect(sprite, *region);
     if (!src_rect.has_value())
     {
         spdlog::error("get sprite {} rect failed", sprite.getTextureId());
@@ -61,22 +64,16 @@ void Renderer::drawSprite(const Camera& camera, const Sprite& sprite, const glm:
     if (!isRectInViewPort(camera, dest_rect))
         return;
 
-    if (!SDL_RenderTextureRotated(renderer_, texture, &src_rect.value(), &dest_rect, angle, NULL, sprite.isFlipped() ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE))
-    {
-        spdlog::error("SDL_RenderTextureRotated failed for texture {}. Error: {}", sprite.getTextureId(), SDL_GetError());
-    }
+    submit(makeQuad(*region, src_rect.value(), dest_rect, angle, sprite.isFlipped()), current_layer_);
 }
 
 void Renderer::drawParallax(const Camera& camera, const Sprite& sprite, const glm::vec2& position, const glm::vec2& scroll_factor, const glm::bvec2 repeat, const glm::vec2& scale)
 {
-    auto texture = resource_manager_->getTexture(sprite.getTextureId());
-    if (!texture)
-    {
-        spdlog::error("getTexture {} failed", sprite.getTextureId());
+    const auto* region = resolveTexture(sprite);
+    if (!region)
         return;
-    }
 
-    auto src_rect = getSpritesRect(sprite);
+    auto src_rect = getSpritesRect(sprite, *region);
     if (!src_rect.has_value())
     {
         spdlog::error("get sprite {} rect failed", sprite.getTextureId());
@@ -113,30 +110,61 @@ void Renderer::drawParallax(const Camera& camera, const Sprite& sprite, const gl
         end.y = glm::min(position_screen.y + scaled_tex_h, viewport_size.y);
     }
 
-    for (float y = start.y; y < end.y; y += scaled_tex_h)
+    if (start.x >= end.x || start.y >= end.y)
+        return;
+
+    // a non repeating axis covers exactly one copy of the image, a repeating one the rest of the viewport
+    glm::vec2 tile_size = {scaled_tex_w, scaled_tex_h};
+    glm::vec2 extent = {repeat.x ? end.x - start.x : scaled_tex_w, repeat.y ? end.y - start.y : scaled_tex_h};
+
+    bool whole_texture = src_rect->x == 0.0f && src_rect->y == 0.0f && src_rect->w == region->texture_width && src_rect->h == region->texture_height;
+
+    RenderCommand command;
+    command.type = RenderCommandType::PARALLAX;
+    command.texture = region->texture;
+    command.texture_size = {region->texture_width, region->texture_height};
+    command.src_rect = src_rect.value();
+    command.dest_rect = {start.x, start.y, extent.x, extent.y};
+    command.repeats = extent / tile_size;
+    command.scale = scale;
+    command.wrap_sampler = texture_wrapping_supported_ && whole_texture;
+    submit(command, current_layer_);
+}
+
+void Renderer::drawUISprite(const Sprite& sprite, const glm::vec2& position, const std::optional<glm::vec2>& size)
+{
+    // UI drawn after this frame's composite (e.g. on top of text) bypasses the cache
+    const bool use_cache = ui_cache_enabled_ && !ui_composited_;
+    if (use_cache)
     {
-        for (float x = start.x; x < end.x; x += scaled_tex_w)
+        if (!ui_pending_ && !ui_full_dirty_ && ui_texture_)
         {
-            SDL_FRect dest_rect = {x, y, scaled_tex_w, scaled_tex_h};
-            if (!SDL_RenderTexture(renderer_, texture, nullptr, &dest_rect))
+            // the output was resized: the cache is rebuilt at the new size from this frame's UI
+            float texture_width = 0.0f;
+            float texture_height = 0.0f;
+            SDL_GetTextureSize(ui_texture_.get(), &texture_width, &texture_height);
+            if (glm::ivec2(static_cast<int>(texture_width), static_cast<int>(texture_height)) != getUICacheSize())
             {
-                spdlog::error("SDL_RenderTexture failed for texture {}. Error: {}", sprite.getTextureId(), SDL_GetError());
-                return;
+                markUIDirty();
             }
         }
+        ui_pending_ = true;
+        if (!isUIDirty())
+            return;
     }
-}
 
-void Renderer::drawUISprite(const Sprite& sprite, const glm::vec2& position, const std::optional<glm::vec2>& size)
-{
-    auto texture = resource_manager_->getTexture(sprite.getTextureId());
-    if (!texture)
+    const auto* region = resolveTexture(sprite);
+    if (!region)
     {
-        spdlog::error("getTexture {} failed", sprite.getTextureId());
+        // the cached layer would otherwise keep the gap until something else dirties it
+        if (use_cache && resource_manager_->isTexturePending(sprite.getTextureHandle()))
+        {
+            ui_retry_ = true;
+        }
         return;
     }
 
-    auto src_rect = getSpritesRect(sprite);
+    auto src_rect = getSpritesRect(sprite, *region);
     if (!src_rect.has_value())
     {
         spdlog::error("get sprite {} rect failed", sprite.getTextureId());
@@ -155,15 +183,266 @@ void Renderer::drawUISprite(const Sprite& sprite, const glm::vec2& position, con
         dest_rect.h = src_rect->h;
     }
 
-    if (!SDL_RenderTextureRotated(renderer_, texture, &src_rect.value(), &dest_rect, 0.0f, nullptr, sprite.isFlipped() ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE))
+    if (use_cache)
+    {
+        ui_commands_.push_back(makeQuad(*region, src_rect.value(), dest_rect, 0.0f, sprite.isFlipped()));
+        return;
+    }
+
+    submit(makeQuad(*region, src_rect.value(), dest_rect, 0.0f, sprite.isFlipped()), UI_LAYER);
+}
+
+void Renderer::drawTexture(SDL_Texture* texture, const SDL_FRect& src_rect, const SDL_FRect& dest_rect)
+{
+    engine::resource::TextureRegion region;
+    region.texture = texture;
+    if (texture == nullptr || !SDL_GetTextureSize(texture, &region.texture_width, &region.texture_height))
     {
-        spdlog::error("SDL_RenderTextureRotated failed for texture {}. Error: {}", sprite.getTextureId(), SDL_GetError());
+        spdlog::error("drawTexture called with invalid texture. Error: {}", SDL_GetError());
+        return;
     }
+    submit(makeQuad(region, src_rect, dest_rect, 0.0f, false), current_layer_);
+}
+
+void Renderer::drawText(TTF_Text* text, const glm::vec2& position)
+{
+    if (text == nullptr)
+        return;
+
+    RenderCommand command;
+    command.type = RenderCommandType::TEXT;
+    command.text = text;
+    command.dest_rect = {position.x, position.y, 0.0f, 0.0f};
+    submit(command, UI_LAYER);
 }
 
 void Renderer::present()
 {
+    flush();
     SDL_RenderPresent(renderer_);
+    ++frame_index_;
+
+    last_frame_stats_ = frame_stats_;
+    frame_stats_ = {};
+    ui_composited_ = false;
+
+    uint64_t now = SDL_GetTicks();
+    if (now - ui_rate_window_start_ >= 1000)
+    {
+        ui_rebuilds_per_second_ = ui_rate_window_start_ == 0 ? 0.0f : static_cast<float>(ui_rebuilds_) * 1000.0f / static_cast<float>(now - ui_rate_window_start_);
+        ui_rebuilds_ = 0;
+        ui_rate_window_start_ = now;
+    }
+}
+
+void Renderer::flush()
+{
+    if (!queue_.empty())
+    {
+        for (const auto& command : queue_.sort())
+        {
+            executeCommand(command);
+        }
+        queue_.clear();
+    }
+    if (ui_pending_)
+    {
+        ui_pending_ = false;
+        compositeUI();
+    }
+    flushBatch();
+}
+
+void Renderer::setDeferred(bool deferred)
+{
+    if (!deferred)
+    {
+        flush();
+    }
+    deferred_ = deferred;
+    spdlog::trace("Renderer deferred mode {}", deferred ? "enabled" : "disabled");
+}
+
+void Renderer::setLayer(uint8_t layer)
+{
+    current_layer_ = layer;
+}
+
+void Renderer::setLayerSortMode(uint8_t layer, LayerSortMode mode)
+{
+    queue_.setLayerSortMode(layer, mode);
+}
+
+void Renderer::flushBatch()
+{
+    if (batch_indices_.empty())
+        return;
+
+    ++frame_stats_.draw_calls;
+    if (!SDL_RenderGeometry(renderer_, batch_texture_, batch_vertices_.data(), static_cast<int>(batch_vertices_.size()), batch_indices_.data(), static_cast<int>(batch_indices_.size())))
+    {
+        spdlog::error("SDL_RenderGeometry failed for sprite batch. Error: {}", SDL_GetError());
+    }
+
+    batch_vertices_.clear();
+    batch_indices_.clear();
+    batch_texture_ = nullptr;
+}
+
+void Renderer::setBatchingEnabled(bool enabled)
+{
+    if (!enabled)
+    {
+        flushBatch();
+    }
+    batching_enabled_ = enabled;
+    spdlog::trace("Renderer sprite batching {}", enabled ? "enabled" : "disabled");
+}
+
+void Renderer::setUICacheEnabled(bool enabled)
+{
+    ui_cache_enabled_ = enabled;
+    ui_commands_.clear();
+    ui_pending_ = false;
+    if (!enabled)
+    {
+        ui_texture_.reset();
+    }
+    markUIDirty();
+    spdlog::trace("Renderer UI cache {}", enabled ? "enabled" : "disabled");
+}
+
+void Renderer::markUIDirty()
+{
+    ui_full_dirty_ = true;
+    ui_dirty_rect_.reset();
+}
+
+void Renderer::markUIDirty(const SDL_FRect& rect)
+{
+    if (ui_full_dirty_)
+        return;
+
+    if (ui_dirty_rect_.has_value())
+    {
+        SDL_FRect merged;
+        SDL_GetRectUnionFloat(&ui_dirty_rect_.value(), &rect, &merged);
+        ui_dirty_rect_ = merged;
+    }
+    else
+    {
+        ui_dirty_rect_ = rect;
+    }
+}
+
+glm::ivec2 Renderer::getUICacheSize() const
+{
+    int width = 0;
+    int height = 0;
+    SDL_RendererLogicalPresentation mode;
+    SDL_GetRenderLogicalPresentation(renderer_, &width, &height, &mode);
+    if (width == 0 || height == 0)
+    {
+        SDL_GetCurrentRenderOutputSize(renderer_, &width, &height);
+    }
+    return {width, height};
+}
+
+void Renderer::compositeUI()
+{
+    ui_composited_ = true;
+
+    const glm::ivec2 size = getUICacheSize();
+    const int width = size.x;
+    const int height = size.y;
+
+    float texture_width = 0.0f;
+    float texture_height = 0.0f;
+    if (ui_texture_)
+    {
+        SDL_GetTextureSize(ui_texture_.get(), &texture_width, &texture_height);
+    }
+    if (!ui_texture_ || static_cast<int>(texture_width) != width || static_cast<int>(texture_height) != height)
+    {
+        ui_texture_.reset(SDL_CreateTexture(renderer_, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_TARGET, width, height));
+        if (!ui_texture_)
+        {
+            spdlog::error("Failed to create UI cache texture {}x{}. Error: {}", width, height, SDL_GetError());
+            ui_commands_.clear();
+            return;
+        }
+        // UI blended into the cleared target leaves premultiplied color
+        SDL_SetTextureBlendMode(ui_texture_.get(), SDL_BLENDMODE_BLEND_PREMULTIPLIED);
+        SDL_SetTextureScaleMode(ui_texture_.get(), SDL_SCALEMODE_NEAREST);
+        // a new texture has no cached pixels, redraw all of this frame's UI into it
+        markUIDirty();
+    }
+
+    if (isUIDirty())
+    {
+        rebuildUI();
+    }
+
+    engine::resource::TextureRegion region;
+    region.texture = ui_texture_.get();
+    region.texture_width = static_cast<float>(width);
+    region.texture_height = static_cast<float>(height);
+    SDL_FRect rect = {0.0f, 0.0f, static_cast<float>(width), static_cast<float>(height)};
+    submitQuad(makeQuad(region, rect, rect, 0.0f, false));
+}
+
+void Renderer::rebuildUI()
+{
+    flushBatch();
+
+    SDL_Texture* previous_target = SDL_GetRenderTarget(renderer_);
+    if (!SDL_SetRenderTarget(renderer_, ui_texture_.get()))
+    {
+        spdlog::error("Failed to set UI cache as render target. Error: {}", SDL_GetError());
+        ui_commands_.clear();
+        return;
+    }
+
+    SDL_FColor previous_color;
+    SDL_BlendMode previous_blend;
+    SDL_GetRenderDrawColorFloat(renderer_, &previous_color.r, &previous_color.g, &previous_color.b, &previous_color.a);
+    SDL_GetRenderDrawBlendMode(renderer_, &previous_blend);
+    SDL_SetRenderDrawColorFloat(renderer_, 0.0f, 0.0f, 0.0f, 0.0f);
+
+    if (ui_full_dirty_)
+    {
+        SDL_RenderClear(renderer_);
+    }
+    else
+    {
+        // clip to the dirty area so untouched UI keeps its cached pixels
+        const SDL_FRect& dirty = ui_dirty_rect_.value();
+        SDL_Rect clip = {static_cast<int>(std::floor(dirty.x)), static_cast<int>(std::floor(dirty.y)), static_cast<int>(std::ceil(dirty.x + dirty.w)) - static_cast<int>(std::floor(dirty.x)), static_cast<int>(std::ceil(dirty.y + dirty.h)) - static_cast<int>(std::floor(dirty.y))};
+        SDL_SetRenderClipRect(renderer_, &clip);
+        SDL_SetRenderDrawBlendMode(renderer_, SDL_BLENDMODE_NONE);
+        SDL_FRect clear_rect = {static_cast<float>(clip.x), static_cast<float>(clip.y), static_cast<float>(clip.w), static_cast<float>(clip.h)};
+        SDL_RenderFillRect(renderer_, &clear_rect);
+    }
+
+    for (const auto& command : ui_commands_)
+    {
+        if (ui_full_dirty_ || SDL_HasRectIntersectionFloat(&ui_dirty_rect_.value(), &command.dest_rect))
+        {
+            submitQuad(command);
+        }
+    }
+    flushBatch();
+
+    SDL_SetRenderClipRect(renderer_, nullptr);
+    SDL_SetRenderDrawBlendMode(renderer_, previous_blend);
+    SDL_SetRenderDrawColorFloat(renderer_, previous_color.r, previous_color.g, previous_color.b, previous_color.a);
+    SDL_SetRenderTarget(renderer_, previous_target);
+
+    ui_commands_.clear();
+    ui_full_dirty_ = ui_retry_;
+    ui_retry_ = false;
+    ui_dirty_rect_.reset();
+    ++ui_rebuilds_;
 }
 
 void Renderer::clearScreen()
@@ -190,15 +469,8 @@ void Renderer::setDrawColorFloat(float r, float g, float b, float a)
     }
 }
 
-std::optional<SDL_FRect> Renderer::getSpritesRect(const Sprite& sprite)
+std::optional<SDL_FRect> Renderer::getSpritesRect(const Sprite& sprite, const engine::resource::TextureRegion& region)
 {
-    SDL_Texture* texture = resource_manager_->getTexture(sprite.getTextureId());
-    if (!texture)
-    {
-        spdlog::error("Failed to get texture with ID: {}", sprite.getTextureId());
-        return std::nullopt;
-    }
-
     auto src_rect = sprite.getSourceRect();
     if (src_rect.has_value())
     {
@@ -207,18 +479,53 @@ std::optional<SDL_FRect> Renderer::getSpritesRect(const Sprite& sprite)
             spdlog::error("Texture {} source rect is invalid", sprite.getTextureId());
             return std::nullopt;
         }
-        return src_rect;
+        // sprite source rects are relative to the original image: clamp them to it so they can't sample a
+        // neighbour in the atlas page, then move them into the page
+        float x0 = glm::max(src_rect->x, 0.0f);
+        float y0 = glm::max(src_rect->y, 0.0f);
+        float x1 = glm::min(src_rect->x + src_rect->w, region.rect.w);
+        float y1 = glm::min(src_rect->y + src_rect->h, region.rect.h);
+        if (x1 <= x0 || y1 <= y0)
+        {
+            spdlog::error("Texture {} source rect lies outside the image", sprite.getTextureId());
+            return std::nullopt;
+        }
+        return SDL_FRect{region.rect.x + x0, region.rect.y + y0, x1 - x0, y1 - y0};
     }
     else
     {
-        SDL_FRect result = {0.0f, 0.0f, 0.0f, 0.0f};
-        if (!SDL_GetTextureSize(texture, &result.w, &result.h))
+        if (region.rect.w <= 0 || region.rect.h <= 0)
         {
             spdlog::error("Failed to get size of texture {}", sprite.getTextureId());
             return std::nullopt;
         }
-        return result;
+        return region.rect;
+    }
+}
+
+const engine::resource::TextureRegion* Renderer::resolveTexture(const Sprite& sprite)
+{
+    if (const auto* region = resource_manager_->resolveTexture(sprite.getTextureHandle()))
+    {
+        return region;
+    }
+
+    // still streaming in: skip the draw rather than stall on it
+    if (resource_manager_->isTexturePending(sprite.getTextureHandle()))
+        return nullptr;
+
+    // first draw of this sprite, or its texture was unloaded since: look it up by id once
+    auto handle = async_texture_loading_ ? resource_manager_->loadTextureAsync(sprite.getTextureId()) : resource_manager_->acquireTextureHandle(sprite.getTextureId());
+    sprite.setTextureHandle(handle);
+    if (const auto* region = resource_manager_->resolveTexture(handle))
+    {
+        return region;
     }
+    if (!resource_manager_->isTexturePending(handle))
+    {
+        spdlog::error("getTexture {} failed", sprite.getTextureId());
+    }
+    return nullptr;
 }
 
 bool Renderer::isRectInViewPort(const Camera& camera, const SDL_FRect& rect)
@@ -227,4 +534,178 @@ bool Renderer::isRectInViewPort(const Camera& camera, const SDL_FRect& rect)
     return (rect.x + rect.w >= 0 && rect.x <= viewport_size.x) && (rect.y + rect.h >= 0 && rect.y <= viewport_size.y);
 }
 
+RenderCommand Renderer::makeQuad(const engine::resource::TextureRegion& region, const SDL_FRect& src_rect, const SDL_FRect& dest_rect, float angle, bool is_flipped)
+{
+    RenderCommand command;
+    command.type = RenderCommandType::QUAD;
+    command.texture = region.texture;
+    command.texture_size = {region.texture_width, region.texture_height};
+    command.src_rect = src_rect;
+    command.dest_rect = dest_rect;
+    command.angle = angle;
+    command.is_flipped = is_flipped;
+    return command;
+}
+
+void Renderer::submit(const RenderCommand& command, uint8_t layer)
+{
+    if (deferred_)
+    {
+        queue_.push(layer, command);
+    }
+    else
+    {
+        executeCommand(command);
+    }
+}
+
+void Renderer::executeCommand(const RenderCommand& command)
+{
+    switch (command.type)
+    {
+    case RenderCommandType::QUAD:
+        submitQuad(command);
+        break;
+    case RenderCommandType::PARALLAX:
+        renderParallax(command);
+        break;
+    case RenderCommandType::TEXT:
+        renderText(command);
+        break;
+    }
+}
+
+void Renderer::renderText(const RenderCommand& command)
+{
+    // the cached UI goes under the first text of the frame, quads batched so far go before it
+    if (ui_pending_)
+    {
+        ui_pending_ = false;
+        compositeUI();
+    }
+    flushBatch();
+    ++frame_stats_.draw_calls;
+    if (!TTF_DrawRendererText(command.text, command.dest_rect.x, command.dest_rect.y))
+    {
+        spdlog::error("TTF_DrawRendererText failed. Error: {}", SDL_GetError());
+    }
+}
+
+void Renderer::renderParallax(const RenderCommand& command)
+{
+    // parallax layers are drawn immediately, keep queued sprites in front of them in submission order
+    flushBatch();
+    ++frame_stats_.sprites;
+    ++frame_stats_.draw_calls;
+
+    const SDL_FRect& dest_rect = command.dest_rect;
+    if (command.wrap_sampler)
+    {
+        // one quad, UVs past 1.0 are wrapped by the sampler (SDL picks the wrap address mode for them)
+        SDL_Vertex vertices[4];
+        const SDL_FPoint corners[4] = {{dest_rect.x, dest_rect.y}, {dest_rect.x + dest_rect.w, dest_rect.y}, {dest_rect.x + dest_rect.w, dest_rect.y + dest_rect.h}, {dest_rect.x, dest_rect.y + dest_rect.h}};
+        const SDL_FPoint uvs[4] = {{0.0f, 0.0f}, {command.repeats.x, 0.0f}, {command.repeats.x, command.repeats.y}, {0.0f, command.repeats.y}};
+        for (int i = 0; i < 4; ++i)
+        {
+            vertices[i] = {corners[i], {1.0f, 1.0f, 1.0f, 1.0f}, uvs[i]};
+        }
+        const int indices[6] = {0, 1, 2, 0, 2, 3};
+        if (!SDL_RenderGeometry(renderer_, command.texture, vertices, 4, indices, 6))
+        {
+            spdlog::error("SDL_RenderGeometry failed for parallax layer. Error: {}", SDL_GetError());
+        }
+    }
+    else if (command.scale.x == command.scale.y)
+    {
+        // atlas sub-rects can't use the sampler wrap, SDL tiles them itself
+        if (!SDL_RenderTextureTiled(renderer_, command.texture, &command.src_rect, command.scale.x, &dest_rect))
+        {
+            spdlog::error("SDL_RenderTextureTiled failed for parallax layer. Error: {}", SDL_GetError());
+        }
+    }
+    else
+    {
+        float tile_w = command.src_rect.w * command.scale.x;
+        float tile_h = command.src_rect.h * command.scale.y;
+        frame_stats_.draw_calls += static_cast<int>(glm::ceil(command.repeats.x) * glm::ceil(command.repeats.y)) - 1;
+        for (float y = dest_rect.y; y < dest_rect.y + dest_rect.h; y += tile_h)
+        {
+            for (float x = dest_rect.x; x < dest_rect.x + dest_rect.w; x += tile_w)
+            {
+                SDL_FRect tile_rect = {x, y, tile_w, tile_h};
+                if (!SDL_RenderTexture(renderer_, command.texture, &command.src_rect, &tile_rect))
+                {
+                    spdlog::error("SDL_RenderTexture failed for parallax layer. Error: {}", SDL_GetError());
+                    return;
+                }
+            }
+        }
+    }
+}
+
+void Renderer::submitQuad(const RenderCommand& command)
+{
+    SDL_Texture* texture = command.texture;
+    const SDL_FRect& src_rect = command.src_rect;
+    const SDL_FRect& dest_rect = command.dest_rect;
+    ++frame_stats_.sprites;
+
+    if (!batching_enabled_)
+    {
+        ++frame_stats_.draw_calls;
+        if (!SDL_RenderTextureRotated(renderer_, texture, &src_rect, &dest_rect, command.angle, nullptr, command.is_flipped ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE))
+        {
+            spdlog::error("SDL_RenderTextureRotated failed. Error: {}", SDL_GetError());
+        }
+        return;
+    }
+
+    if (texture != batch_texture_)
+    {
+        flushBatch();
+        batch_texture_ = texture;
+    }
+
+    const glm::vec2& tex_size = command.texture_size;
+    if (tex_size.x <= 0.0f || tex_size.y <= 0.0f)
+    {
+        spdlog::error("Invalid texture size for sprite batch");
+        return;
+    }
+
+    float u0 = src_rect.x / tex_size.x;
+    float v0 = src_rect.y / tex_size.y;
+    float u1 = (src_rect.x + src_rect.w) / tex_size.x;
+    float v1 = (src_rect.y + src_rect.h) / tex_size.y;
+    if (command.is_flipped)
+    {
+        std::swap(u0, u1);
+    }
+
+    // same convention as SDL_RenderTextureRotated: clockwise degrees around the center of dest_rect
+    glm::vec2 center = {dest_rect.x + dest_rect.w * 0.5f, dest_rect.y + dest_rect.h * 0.5f};
+    glm::vec2 half = {dest_rect.w * 0.5f, dest_rect.h * 0.5f};
+    float radians = glm::radians(command.angle);
+    float c = std::cos(radians);
+    float s = std::sin(radians);
+
+    const glm::vec2 corners[4] = {{-half.x, -half.y}, {half.x, -half.y}, {half.x, half.y}, {-half.x, half.y}};
+    const SDL_FPoint uvs[4] = {{u0, v0}, {u1, v0}, {u1, v1}, {u0, v1}};
+
+    int base = static_cast<int>(batch_vertices_.size());
+    for (int i = 0; i < 4; ++i)
+    {
+        SDL_Vertex vertex;
+        vertex.position = {center.x + corners[i].x * c - corners[i].y * s, center.y + corners[i].x * s + corners[i].y * c};
+        vertex.color = {1.0f, 1.0f, 1.0f, 1.0f};
+        vertex.tex_coord = uvs[i];
+        batch_vertices_.push_back(vertex);
+    }
+
+    for (int index : {0, 1, 2, 0, 2, 3})
+    {
+        batch_indices_.push_back(base + index);
+    }
+}
+
 } // namespace engine::render
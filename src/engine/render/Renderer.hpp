@@ -1,19 +1,27 @@
 #pragma once
 
+#include <cstdint>
+#include <memory>
 #include <optional>
+#include <vector>
 
+#include <SDL3/SDL_render.h>
 #include <SDL3/SDL_stdinc.h>
 
+#include "engine/render/RenderQueue.hpp"
 #include "engine/utils/Math.hpp"
 
 struct SDL_Renderer;
+struct SDL_Texture;
 struct SDL_FRect;
 struct SDL_FColor;
+struct TTF_Text;
 
 namespace engine::resource
 {
 class ResourceManager;
-}
+struct TextureRegion;
+} // namespace engine::resource
 
 namespace engine::render
 {
@@ -21,13 +29,66 @@ namespace engine::render
 class Camera;
 class Sprite;
 
+struct RenderStats
+{
+    int draw_calls = 0; // actual SDL draw submissions
+    int sprites = 0;    // quads requested by drawSprite/drawUISprite/drawParallax
+};
+
 class Renderer final
 {
 private:
+    struct SDLTextureDeleter
+    {
+        void operator()(SDL_Texture* texture) const
+        {
+            if (texture)
+            {
+                SDL_DestroyTexture(texture);
+            }
+        }
+    };
+
     SDL_Renderer* renderer_ = nullptr;
     engine::resource::ResourceManager* resource_manager_ = nullptr;
+    bool texture_wrapping_supported_ = false;
+    // sprites whose texture isn't resident yet request it in the background and are skipped until uploaded
+    bool async_texture_loading_ = false;
+
+    // sprite batch: consecutive quads sharing a texture are flushed with one SDL_RenderGeometry
+    bool batching_enabled_ = false;
+    SDL_Texture* batch_texture_ = nullptr;
+    std::vector<SDL_Vertex> batch_vertices_;
+    std::vector<int> batch_indices_;
+
+    // deferred mode: draws are queued as commands and sorted per layer at flush
+    bool deferred_ = false;
+    uint8_t current_layer_ = 0;
+    RenderQueue queue_;
+
+    uint64_t frame_index_ = 0; // presented frames
+    RenderStats frame_stats_;
+    RenderStats last_frame_stats_;
+
+    // retained UI: drawUISprite renders into ui_texture_ only while something is dirty, the texture is
+    // composited with one quad at the first flush after the UI was drawn. A dirty frame records every UI quad,
+    // the rebuild only redraws those touching the dirty rect
+    bool ui_cache_enabled_ = false;
+    std::unique_ptr<SDL_Texture, SDLTextureDeleter> ui_texture_;
+    std::vector<RenderCommand> ui_commands_;
+    bool ui_full_dirty_ = true;
+    std::optional<SDL_FRect> ui_dirty_rect_;
+    bool ui_pending_ = false;
+    bool ui_composited_ = false;
+    bool ui_retry_ = false; // a UI texture was still loading, rebuild again next frame
+    int ui_rebuilds_ = 0;
+    uint64_t ui_rate_window_start_ = 0;
+    float ui_rebuilds_per_second_ = 0.0f;
 
 public:
+    // drawUISprite always goes to the top layer when deferred
+    static constexpr uint8_t UI_LAYER = 255;
+
     Renderer(SDL_Renderer* renderer, engine::resource::ResourceManager* resourceManager);
 
     Renderer(const Renderer&) = delete;
@@ -41,8 +102,40 @@ public:
 
     void drawUISprite(const Sprite& sprite, const glm::vec2& position, const std::optional<glm::vec2>& size = std::nullopt);
 
+    // draws an already resolved texture in screen space, used by cached layers
+    void drawTexture(SDL_Texture* texture, const SDL_FRect& src_rect, const SDL_FRect& dest_rect);
+
+    // screen space text on UI_LAYER, above the cached UI. When deferred the text is drawn at flush, so it has to
+    // stay alive and unchanged until the frame is presented
+    void drawText(TTF_Text* text, const glm::vec2& position);
+
     void present();
     void clearScreen();
+    void flush();
+    // draws the pending sprite batch to the current target, call before switching render targets
+    void flushBatch();
+
+    void setBatchingEnabled(bool enabled);
+    bool isBatchingEnabled() const { return batching_enabled_; }
+    const RenderStats& getLastFrameStats() const { return last_frame_stats_; }
+    uint64_t getFrameIndex() const { return frame_index_; }
+
+    void setAsyncTextureLoading(bool enabled) { async_texture_loading_ = enabled; }
+    bool isAsyncTextureLoading() const { return async_texture_loading_; }
+
+    void setDeferred(bool deferred);
+    bool isDeferred() const { return deferred_; }
+    void setLayer(uint8_t layer);
+    uint8_t getLayer() const { return current_layer_; }
+    void setLayerSortMode(uint8_t layer, LayerSortMode mode);
+
+    void setUICacheEnabled(bool enabled);
+    bool isUICacheEnabled() const { return ui_cache_enabled_; }
+    // redraw the whole cached UI, or only the given screen rect
+    void markUIDirty();
+    void markUIDirty(const SDL_FRect& rect);
+    bool isUIDirty() const { return ui_full_dirty_ || ui_dirty_rect_.has_value(); }
+    float getUIRebuildsPerSecond() const { return ui_rebuilds_per_second_; }
 
     void setDrawColor(Uint8 r, Uint8 g, Uint8 b, Uint8 a = 255);
     void setDrawColorFloat(float r, float g, float b, float a = 1.0f);
@@ -50,7 +143,18 @@ public:
     SDL_Renderer* getSDLRenderer() const { return renderer_; }
 
 private:
-    std::optional<SDL_FRect> getSpritesRect(const Sprite& sprite);
+    std::optional<SDL_FRect> getSpritesRect(const Sprite& sprite, const engine::resource::TextureRegion& region);
     bool isRectInViewPort(const Camera& camera, const SDL_FRect& rect);
+    const engine::resource::TextureRegion* resolveTexture(const Sprite& sprite);
+    RenderCommand makeQuad(const engine::resource::TextureRegion& region, const SDL_FRect& src_rect, const SDL_FRect& dest_rect, float angle, bool is_flipped);
+    void submit(const RenderCommand& command, uint8_t layer);
+    void executeCommand(const RenderCommand& command);
+    void renderParallax(const RenderCommand& command);
+    void renderText(const RenderCommand& command);
+    // logical output size, what the UI cache texture has to match
+    glm::ivec2 getUICacheSize() const;
+    void compositeUI();
+    void rebuildUI();
+    void submitQuad(const RenderCommand& command);
 };
 } // namespace engine::render
@@ -0,0 +1,179 @@
+#include "SpatialGrid.hpp"
+
+#include <cmath>
+#include <stdexcept>
+
+#include <spdlog/spdlog.h>
+
+namespace engine::render
+{
+
+namespace
+{
+uint64_t packCell(int x, int y)
+{
+    return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+}
+
+bool overlaps(const engine::utils::Rect& a, const engine::utils::Rect& b)
+{
+    return a.position.x < b.position.x + b.size.x && b.position.x < a.position.x + a.size.x && a.position.y < b.position.y + b.size.y && b.position.y < a.position.y + a.size.y;
+}
+} // namespace
+
+SpatialGrid::SpatialGrid(float cell_size)
+    : cell_size_(cell_size)
+{
+    if (cell_size_ <= 0.0f)
+    {
+        throw std::runtime_error("Failed to construct SpatialGrid: cell size must be > 0");
+    }
+}
+
+SpatialGrid::ObjectId SpatialGrid::insert(const engine::utils::Rect& bounds, uint32_t user_data)
+{
+    ObjectId id;
+    if (!free_ids_.empty())
+    {
+        id = free_ids_.back();
+        free_ids_.pop_back();
+    }
+    else
+    {
+        id = static_cast<ObjectId>(objects_.size());
+        objects_.emplace_back();
+    }
+
+    Object& object = objects_[id];
+    object.bounds = bounds;
+    object.user_data = user_data;
+    object.is_alive = true;
+    addToCell(id);
+    ++object_count_;
+    return id;
+}
+
+void SpatialGrid::update(ObjectId id, const engine::utils::Rect& bounds)
+{
+    if (id >= objects_.size() || !objects_[id].is_alive)
+    {
+        spdlog::warn("SpatialGrid: update of unknown object {}", id);
+        return;
+    }
+
+    Object& object = objects_[id];
+    object.bounds = bounds;
+
+    bool oversized = isOversized(bounds);
+    if (oversized != object.is_oversized || (!oversized && cellKeyFor(bounds) != object.cell_key))
+    {
+        removeFromCell(id);
+        addToCell(id);
+    }
+}
+
+void SpatialGrid::remove(ObjectId id)
+{
+    if (id >= objects_.size() || !objects_[id].is_alive)
+    {
+        spdlog::warn("SpatialGrid: remove of unknown object {}", id);
+        return;
+    }
+
+    removeFromCell(id);
+    objects_[id].is_alive = false;
+    free_ids_.push_back(id);
+    --object_count_;
+}
+
+void SpatialGrid::clear()
+{
+    cells_.clear();
+    oversized_.clear();
+    objects_.clear();
+    free_ids_.clear();
+    object_count_ = 0;
+}
+
+void SpatialGrid::query(const engine::utils::Rect& area, std::vector<uint32_t>& out) const
+{
+    if (object_count_ == 0)
+        return;
+
+    // an object stored in a cell outside area can still reach into it by up to half a cell
+    const glm::vec2 loose = glm::vec2(cell_size_ * 0.5f);
+    glm::vec2 min = (area.position - loose) / cell_size_;
+    glm::vec2 max = (area.position + area.size + loose) / cell_size_;
+    int first_x = static_cast<int>(std::floor(min.x));
+    int first_y = static_cast<int>(std::floor(min.y));
+    int last_x = static_cast<int>(std::floor(max.x));
+    int last_y = static_cast<int>(std::floor(max.y));
+
+    for (int y = first_y; y <= last_y; ++y)
+    {
+        for (int x = first_x; x <= last_x; ++x)
+        {
+            auto it = cells_.find(packCell(x, y));
+            if (it == cells_.end())
+                continue;
+
+            for (ObjectId id : it->second)
+            {
+                const Object& object = objects_[id];
+                if (overlaps(object.bounds, area))
+                {
+                    out.push_back(object.user_data);
+                }
+            }
+        }
+    }
+
+    for (ObjectId id : oversized_)
+    {
+        const Object& object = objects_[id];
+        if (overlaps(object.bounds, area))
+        {
+            out.push_back(object.user_data);
+        }
+    }
+}
+
+uint64_t SpatialGrid::cellKeyFor(const engine::utils::Rect& bounds) const
+{
+    glm::vec2 center = (bounds.position + bounds.size * 0.5f) / cell_size_;
+    return packCell(static_cast<int>(std::floor(center.x)), static_cast<int>(std::floor(center.y)));
+}
+
+bool SpatialGrid::isOversized(const engine::utils::Rect& bounds) const
+{
+    return bounds.size.x > cell_size_ || bounds.size.y > cell_size_;
+}
+
+std::vector<SpatialGrid::ObjectId>& SpatialGrid::cellOf(const Object& object)
+{
+    return object.is_oversized ? oversized_ : cells_[object.cell_key];
+}
+
+void SpatialGrid::addToCell(ObjectId id)
+{
+    Object& object = objects_[id];
+    object.is_oversized = isOversized(object.bounds);
+    object.cell_key = object.is_oversized ? 0 : cellKeyFor(object.bounds);
+    auto& cell = cellOf(object);
+    object.index_in_cell = static_cast<uint32_t>(cell.size());
+    cell.push_back(id);
+}
+
+void SpatialGrid::removeFromCell(ObjectId id)
+{
+    auto& cell = cellOf(objects_[id]);
+    uint32_t index = objects_[id].index_in_cell;
+
+    // swap with the last entry so removal is O(1)
+    ObjectId moved = cell.back();
+    cell[index] = moved;
+    objects_[moved].index_in_cell = index;
+    cell.pop_back();
+}
+
+} // namespace engine::render
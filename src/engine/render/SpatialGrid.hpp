@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "engine/utils/Math.hpp"
+
+namespace engine::render
+{
+
+// Loose uniform grid over world-space bounds. Objects live in the cell of their center only, so moving an object
+// is O(1); queries widen the searched cells by half a cell, the most such an object may reach out of its cell.
+// Objects bigger than a cell are kept in a separate list that every query scans.
+class SpatialGrid final
+{
+public:
+    using ObjectId = uint32_t;
+    static constexpr ObjectId INVALID_ID = 0xFFFFFFFFu;
+
+private:
+    struct Object
+    {
+        engine::utils::Rect bounds;
+        uint32_t user_data = 0;
+        uint64_t cell_key = 0;
+        uint32_t index_in_cell = 0; // in oversized_ if is_oversized
+        bool is_alive = false;
+        bool is_oversized = false;
+    };
+
+    float cell_size_;
+    std::unordered_map<uint64_t, std::vector<ObjectId>> cells_;
+    std::vector<ObjectId> oversized_;
+    std::vector<Object> objects_;
+    std::vector<ObjectId> free_ids_;
+    size_t object_count_ = 0;
+
+public:
+    explicit SpatialGrid(float cell_size = 128.0f);
+
+    SpatialGrid(const SpatialGrid&) = delete;
+    SpatialGrid& operator=(const SpatialGrid&) = delete;
+    SpatialGrid(SpatialGrid&&) = default;
+    SpatialGrid& operator=(SpatialGrid&&) = default;
+
+    ObjectId insert(const engine::utils::Rect& bounds, uint32_t user_data);
+    void update(ObjectId id, const engine::utils::Rect& bounds);
+    void remove(ObjectId id);
+    void clear();
+
+    // appends user_data of every object overlapping area to out
+    void query(const engine::utils::Rect& area, std::vector<uint32_t>& out) const;
+
+    size_t size() const { return object_count_; }
+
+private:
+    uint64_t cellKeyFor(const engine::utils::Rect& bounds) const;
+    bool isOversized(const engine::utils::Rect& bounds) const;
+    std::vector<ObjectId>& cellOf(const Object& object);
+    // files the object by its current bounds
+    void addToCell(ObjectId id);
+    void removeFromCell(ObjectId id);
+};
+
+} // namespace engine::render
@@ -7,6 +7,8 @@
 #include <string>
 #include <string_view>
 
+#include "engine/resource/TextureHandle.hpp"
+
 namespace engine::render
 {
 
@@ -16,6 +18,8 @@ private:
     std::string texture_id_;
     std::optional<SDL_FRect> source_rect_;
     bool is_flipped_ = false;
+    // resolved by the Renderer on first draw, re-resolved by id if it goes stale
+    mutable engine::resource::TextureHandle texture_handle_;
 
 public:
     Sprite(std::string_view testure_id, const std::optional<SDL_FRect>& source_rect = std::nullopt, bool is_flipped = false)
@@ -29,7 +33,14 @@ public:
     const std::optional<SDL_FRect>& getSourceRect() const { return source_rect_; }
     bool isFlipped() const { return is_flipped_; }
 
-    void setTextureId(std::string_view texture_id) { texture_id_ = std::string(texture_id); }
+    engine::resource::TextureHandle getTextureHandle() const { return texture_handle_; }
+    void setTextureHandle(engine::resource::TextureHandle handle) const { texture_handle_ = handle; }
+
+    void setTextureId(std::string_view texture_id)
+    {
+        texture_id_ = std::string(texture_id);
+        texture_handle_ = {};
+    }
     void setSourceRect(std::optional<SDL_FRect> source_rect) { source_rect_ = std::move(source_rect); }
     void setFlipped(bool is_flipped) { is_flipped_ = is_flipped; }
 };
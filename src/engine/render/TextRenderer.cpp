@@ -0,0 +1,230 @@
+#include "TextRenderer.hpp"
+
+#include <stdexcept>
+
+#include <spdlog/spdlog.h>
+
+#include "engine/render/Renderer.hpp"
+
+namespace engine::render
+{
+
+namespace
+{
+// minimal UTF-8 decoder, invalid bytes are returned as themselves
+char32_t nextCodepoint(std::string_view text, size_t& i)
+{
+    auto byte = static_cast<unsigned char>(text[i++]);
+    int extra = byte >= 0xF0 ? 3 : byte >= 0xE0 ? 2 : byte >= 0xC0 ? 1 : 0;
+    char32_t codepoint = extra == 0 ? byte : byte & (0x3F >> extra);
+    for (; extra > 0 && i < text.size(); --extra)
+    {
+        codepoint = (codepoint << 6) | (static_cast<unsigned char>(text[i++]) & 0x3F);
+    }
+    return codepoint;
+}
+} // namespace
+
+TextRenderer::TextRenderer(Renderer* renderer, size_t max_cached_texts, size_t glyph_budget_bytes)
+    : renderer_(renderer)
+    , max_cached_texts_(max_cached_texts)
+    , glyph_budget_bytes_(glyph_budget_bytes)
+{
+    if (renderer_ == nullptr)
+    {
+        throw std::runtime_error("Failed to construct TextRenderer: input renderer is nullptr");
+    }
+    if (!ensureEngine())
+    {
+        throw std::runtime_error(std::string("Failed to construct TextRenderer: TTF_CreateRendererTextEngine failed. SDL error: ") + SDL_GetError());
+    }
+    spdlog::trace("TextRenderer constructed");
+}
+
+TextRenderer::~TextRenderer()
+{
+    // texts must go before the engine that owns their glyphs
+    texts_.clear();
+    retired_texts_.clear();
+    engine_.reset();
+    retired_engines_.clear();
+}
+
+void TextRenderer::drawText(std::string_view label, TTF_Font* font, std::string_view text, const glm::vec2& position, const engine::utils::FColor& color)
+{
+    if (font == nullptr || text.empty())
+        return;
+
+    releaseRetired();
+    trackGlyphs(font, text);
+    if (!ensureEngine())
+        return;
+
+    auto it = texts_.find(std::string(label));
+    if (it == texts_.end())
+    {
+        if (texts_.size() >= max_cached_texts_)
+        {
+            evictLeastRecentlyUsed();
+        }
+
+        TTF_Text* created = TTF_CreateText(engine_.get(), font, text.data(), text.size());
+        if (created == nullptr)
+        {
+            spdlog::error("TextRenderer: TTF_CreateText failed for {}. SDL error: {}", label, SDL_GetError());
+            return;
+        }
+        CachedText cached;
+        cached.text.reset(created);
+        cached.font = font;
+        cached.content = std::string(text);
+        it = texts_.emplace(std::string(label), std::move(cached)).first;
+    }
+    else
+    {
+        CachedText& cached = it->second;
+        if (cached.font != font)
+        {
+            TTF_SetTextFont(cached.text.get(), font);
+            cached.font = font;
+            ++relayouts_;
+        }
+        if (cached.content != text)
+        {
+            // only the layout changes, glyphs already live in the atlas
+            TTF_SetTextString(cached.text.get(), text.data(), text.size());
+            cached.content.assign(text);
+            ++relayouts_;
+        }
+    }
+
+    CachedText& cached = it->second;
+    cached.last_used = ++use_counter_;
+    TTF_SetTextColorFloat(cached.text.get(), color.r, color.g, color.b, color.a);
+
+    renderer_->drawText(cached.text.get(), position);
+}
+
+glm::vec2 TextRenderer::getTextSize(std::string_view label) const
+{
+    auto it = texts_.find(std::string(label));
+    if (it == texts_.end())
+        return {0.0f, 0.0f};
+
+    int w = 0;
+    int h = 0;
+    TTF_GetTextSize(it->second.text.get(), &w, &h);
+    return {static_cast<float>(w), static_cast<float>(h)};
+}
+
+void TextRenderer::removeText(std::string_view label)
+{
+    auto it = texts_.find(std::string(label));
+    if (it == texts_.end())
+        return;
+
+    retire(std::move(it->second.text));
+    texts_.erase(it);
+}
+
+void TextRenderer::clear()
+{
+    releaseRetired();
+    for (auto& [label, cached] : texts_)
+    {
+        retire(std::move(cached.text));
+    }
+    texts_.clear();
+    if (engine_)
+    {
+        retired_engines_.push_back(std::move(engine_));
+        retired_frame_ = renderer_->getFrameIndex();
+    }
+    atlas_glyphs_.clear();
+    atlas_bytes_estimate_ = 0;
+}
+
+bool TextRenderer::ensureEngine()
+{
+    if (engine_)
+        return true;
+
+    engine_.reset(TTF_CreateRendererTextEngine(renderer_->getSDLRenderer()));
+    if (!engine_)
+    {
+        spdlog::error("TextRenderer: TTF_CreateRendererTextEngine failed. SDL error: {}", SDL_GetError());
+        return false;
+    }
+    return true;
+}
+
+void TextRenderer::trackGlyphs(TTF_Font* font, std::string_view text)
+{
+    // only new glyphs can push the atlas over, a text that is over budget on its own resets it once
+    if (!insertGlyphs(font, text) || atlas_bytes_estimate_ <= glyph_budget_bytes_)
+        return;
+
+    // the text engine can't drop single glyphs, start over with an empty atlas
+    spdlog::info("TextRenderer: glyph atlas over budget ({} KB), resetting", atlas_bytes_estimate_ / 1024);
+    clear();
+    ++atlas_resets_;
+    insertGlyphs(font, text);
+    if (atlas_bytes_estimate_ > glyph_budget_bytes_)
+    {
+        spdlog::warn("TextRenderer: one text needs {} KB of glyphs, over the {} KB budget", atlas_bytes_estimate_ / 1024, glyph_budget_bytes_ / 1024);
+    }
+}
+
+bool TextRenderer::insertGlyphs(TTF_Font* font, std::string_view text)
+{
+    const auto font_bits = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(font)) << 21;
+    const float font_size = TTF_GetFontSize(font);
+    const auto glyph_bytes = static_cast<size_t>(font_size * font_size * 4.0f);
+
+    bool inserted = false;
+    for (size_t i = 0; i < text.size();)
+    {
+        char32_t codepoint = nextCodepoint(text, i);
+        if (atlas_glyphs_.insert(font_bits ^ codepoint).second)
+        {
+            atlas_bytes_estimate_ += glyph_bytes;
+            inserted = true;
+        }
+    }
+    return inserted;
+}
+
+void TextRenderer::retire(std::unique_ptr<TTF_Text, SDLTextDeleter> text)
+{
+    retired_texts_.push_back(std::move(text));
+    retired_frame_ = renderer_->getFrameIndex();
+}
+
+void TextRenderer::releaseRetired()
+{
+    if (renderer_->getFrameIndex() == retired_frame_)
+        return;
+
+    retired_texts_.clear();
+    retired_engines_.clear();
+}
+
+void TextRenderer::evictLeastRecentlyUsed()
+{
+    auto oldest = texts_.end();
+    for (auto it = texts_.begin(); it != texts_.end(); ++it)
+    {
+        if (oldest == texts_.end() || it->second.last_used < oldest->second.last_used)
+        {
+            oldest = it;
+        }
+    }
+    if (oldest != texts_.end())
+    {
+        spdlog::trace("TextRenderer: evicting text {}", oldest->first);
+        retire(std::move(oldest->second.text));
+        texts_.erase(oldest);
+    }
+}
+
+} // namespace engine::render
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <SDL3_ttf/SDL_ttf.h>
+#include <glm/vec2.hpp>
+
+#include "engine/utils/Math.hpp"
+#include "engine/utils/Utils.hpp"
+
+namespace engine::render
+{
+
+class Renderer;
+
+// HUD text on top of SDL_ttf's renderer text engine: glyphs are rasterized once into the engine's shared
+// atlas, each label keeps its TTF_Text so changing the string only re-lays it out.
+class TextRenderer final
+{
+private:
+    struct SDLTextEngineDeleter
+    {
+        void operator()(TTF_TextEngine* engine) const
+        {
+            if (engine)
+            {
+                TTF_DestroyRendererTextEngine(engine);
+            }
+        }
+    };
+
+    struct SDLTextDeleter
+    {
+        void operator()(TTF_Text* text) const
+        {
+            if (text)
+            {
+                TTF_DestroyText(text);
+            }
+        }
+    };
+
+    struct CachedText
+    {
+        std::unique_ptr<TTF_Text, SDLTextDeleter> text;
+        TTF_Font* font = nullptr;
+        std::string content;
+        uint64_t last_used = 0;
+    };
+
+    Renderer* renderer_ = nullptr;
+    std::unique_ptr<TTF_TextEngine, SDLTextEngineDeleter> engine_;
+    std::unordered_map<std::string, CachedText, StdStringHash> texts_;
+    // dropped texts and engines stay alive until the frame that may still draw them has been presented
+    std::vector<std::unique_ptr<TTF_Text, SDLTextDeleter>> retired_texts_;
+    std::vector<std::unique_ptr<TTF_TextEngine, SDLTextEngineDeleter>> retired_engines_;
+    uint64_t retired_frame_ = 0;
+
+    size_t max_cached_texts_;
+    size_t glyph_budget_bytes_;
+    // (font, codepoint) pairs already in the atlas and their estimated size
+    std::unordered_set<uint64_t> atlas_glyphs_;
+    size_t atlas_bytes_estimate_ = 0;
+
+    uint64_t use_counter_ = 0;
+    int relayouts_ = 0;
+    int atlas_resets_ = 0;
+
+public:
+    TextRenderer(Renderer* renderer, size_t max_cached_texts = 256, size_t glyph_budget_bytes = 16 * 1024 * 1024);
+    ~TextRenderer();
+
+    TextRenderer(const TextRenderer&) = delete;
+    TextRenderer& operator=(const TextRenderer&) = delete;
+    TextRenderer(TextRenderer&&) = delete;
+    TextRenderer& operator=(TextRenderer&&) = delete;
+
+    // label identifies the text slot (e.g. "hud.score"), text can change every frame without creating textures.
+    // Drawn through the renderer on its UI layer; a label is drawn at most once per frame
+    void drawText(std::string_view label, TTF_Font* font, std::string_view text, const glm::vec2& position, const engine::utils::FColor& color = {1.0f, 1.0f, 1.0f, 1.0f});
+    glm::vec2 getTextSize(std::string_view label) const;
+    void removeText(std::string_view label);
+    // drops all cached layouts and the glyph atlas
+    void clear();
+
+    int getRelayoutCount() const { return relayouts_; }
+    int getAtlasResetCount() const { return atlas_resets_; }
+
+private:
+    bool ensureEngine();
+    void trackGlyphs(TTF_Font* font, std::string_view text);
+    // returns whether any glyph of text was new to the atlas
+    bool insertGlyphs(TTF_Font* font, std::string_view text);
+    void retire(std::unique_ptr<TTF_Text, SDLTextDeleter> text);
+    void releaseRetired();
+    void evictLeastRecentlyUsed();
+};
+
+} // namespace engine::render
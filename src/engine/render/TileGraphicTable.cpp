@@ -0,0 +1,104 @@
+#include "TileGraphicTable.hpp"
+
+#include <exception>
+#include <filesystem>
+#include <fstream>
+
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+
+namespace engine::render
+{
+
+void TileGraphicTable::addTileSheet(uint32_t first_gid, std::string_view texture_id, int tile_count, int columns, const glm::ivec2& tile_size, int margin, int spacing)
+{
+    if (tile_count <= 0 || columns <= 0 || tile_size.x <= 0 || tile_size.y <= 0)
+    {
+        spdlog::error("TileGraphicTable: invalid tile sheet {} (count {}, columns {})", texture_id, tile_count, columns);
+        return;
+    }
+
+    auto texture = engine::resource::AssetId::intern(texture_id);
+    for (int id = 0; id < tile_count; ++id)
+    {
+        TileGraphic graphic;
+        graphic.texture_id = texture;
+        graphic.source_rect = {
+            static_cast<float>(margin + (id % columns) * (tile_size.x + spacing)),
+            static_cast<float>(margin + (id / columns) * (tile_size.y + spacing)),
+            static_cast<float>(tile_size.x),
+            static_cast<float>(tile_size.y),
+        };
+        set(first_gid + static_cast<uint32_t>(id), std::move(graphic));
+    }
+}
+
+void TileGraphicTable::addImageTile(uint32_t gid, std::string_view texture_id, const glm::vec2& image_size)
+{
+    TileGraphic graphic;
+    graphic.texture_id = engine::resource::AssetId::intern(texture_id);
+    graphic.source_rect = {0.0f, 0.0f, image_size.x, image_size.y};
+    set(gid, std::move(graphic));
+}
+
+bool TileGraphicTable::loadTileset(uint32_t first_gid, std::string_view tileset_path)
+{
+    std::ifstream file{std::filesystem::path(tileset_path)};
+    if (!file.is_open())
+    {
+        spdlog::error("TileGraphicTable: failed to open tileset {}", tileset_path);
+        return false;
+    }
+
+    try
+    {
+        nlohmann::json j;
+        file >> j;
+
+        const std::filesystem::path base_dir = std::filesystem::path(tileset_path).parent_path();
+        auto resolve = [&base_dir](const std::string& image) { return (base_dir / image).lexically_normal().generic_string(); };
+
+        if (j.contains("image"))
+        {
+            addTileSheet(first_gid, resolve(j["image"].get<std::string>()), j.value("tilecount", 0), j.value("columns", 0), glm::ivec2(j.value("tilewidth", 0), j.value("tileheight", 0)), j.value("margin", 0), j.value("spacing", 0));
+        }
+        else if (j.contains("tiles"))
+        {
+            for (const auto& tile : j["tiles"])
+            {
+                if (!tile.contains("image"))
+                    continue;
+                addImageTile(first_gid + tile.value("id", 0u), resolve(tile["image"].get<std::string>()), glm::vec2(tile.value("imagewidth", 0.0f), tile.value("imageheight", 0.0f)));
+            }
+        }
+        spdlog::trace("TileGraphicTable: loaded tileset {} at first gid {}", tileset_path, first_gid);
+        return true;
+    }
+    catch (const std::exception& e)
+    {
+        spdlog::error("TileGraphicTable: failed to parse tileset {}. Error: {}", tileset_path, e.what());
+    }
+    return false;
+}
+
+const TileGraphic* TileGraphicTable::find(uint32_t gid) const
+{
+    gid &= TILE_GID_MASK;
+    if (gid >= graphics_.size() || !graphics_[gid].has_value())
+    {
+        return nullptr;
+    }
+    return &graphics_[gid].value();
+}
+
+void TileGraphicTable::set(uint32_t gid, TileGraphic graphic)
+{
+    if (gid >= graphics_.size())
+    {
+        graphics_.resize(gid + 1);
+    }
+    max_tile_size_ = glm::max(max_tile_size_, glm::vec2(graphic.source_rect.w, graphic.source_rect.h));
+    graphics_[gid] = std::move(graphic);
+}
+
+} // namespace engine::render
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <SDL3/SDL_rect.h>
+#include <glm/vec2.hpp>
+
+#include "engine/resource/AssetId.hpp"
+
+namespace engine::render
+{
+
+// Tiled GID flag bits, the remaining bits are the tile id
+inline constexpr uint32_t TILE_FLIPPED_HORIZONTALLY = 0x80000000u;
+inline constexpr uint32_t TILE_FLIPPED_VERTICALLY = 0x40000000u;
+inline constexpr uint32_t TILE_FLIPPED_DIAGONALLY = 0x20000000u;
+inline constexpr uint32_t TILE_ROTATED_HEXAGONAL_120 = 0x10000000u;
+inline constexpr uint32_t TILE_GID_MASK = 0x0FFFFFFFu;
+
+struct TileGraphic
+{
+    engine::resource::AssetId texture_id; // interned when the tile is added
+    SDL_FRect source_rect = {0.0f, 0.0f, 0.0f, 0.0f};
+};
+
+// Maps global tile ids of a map to the texture and source rect used to draw them.
+class TileGraphicTable final
+{
+private:
+    std::vector<std::optional<TileGraphic>> graphics_;
+    glm::vec2 max_tile_size_ = {0.0f, 0.0f};
+
+public:
+    TileGraphicTable() = default;
+
+    // image based tileset, tiles are cut from one sheet
+    void addTileSheet(uint32_t first_gid, std::string_view texture_id, int tile_count, int columns, const glm::ivec2& tile_size, int margin = 0, int spacing = 0);
+    // single tile of an image collection tileset
+    void addImageTile(uint32_t gid, std::string_view texture_id, const glm::vec2& image_size);
+    // reads an external .tsj tileset, image paths are resolved relative to the tileset file
+    bool loadTileset(uint32_t first_gid, std::string_view tileset_path);
+
+    const TileGraphic* find(uint32_t gid) const;
+    const glm::vec2& getMaxTileSize() const { return max_tile_size_; }
+
+private:
+    void set(uint32_t gid, TileGraphic graphic);
+};
+
+} // namespace engine::render
@@ -0,0 +1,285 @@
+#include "TileLayerRenderer.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+#include <glm/glm.hpp>
+#include <spdlog/spdlog.h>
+
+#include "engine/render/Camera.hpp"
+#include "engine/render/Renderer.hpp"
+#include "engine/render/TileGraphicTable.hpp"
+#include "engine/resource/ResourceManager.hpp"
+
+namespace engine::render
+{
+
+TileLayerRenderer::TileLayerRenderer(Renderer* renderer, engine::resource::ResourceManager* resource_manager, const TileGraphicTable* tile_graphics, const glm::ivec2& map_size, const glm::ivec2& tile_size, std::vector<uint32_t> gids, int chunk_pixels, const glm::vec2& offset)
+    : renderer_(renderer)
+    , resource_manager_(resource_manager)
+    , tile_graphics_(tile_graphics)
+    , map_size_(map_size)
+    , tile_size_(tile_size)
+    , offset_(offset)
+    , chunk_pixels_(chunk_pixels)
+    , gids_(std::move(gids))
+{
+    if (renderer_ == nullptr || resource_manager_ == nullptr || tile_graphics_ == nullptr)
+    {
+        throw std::runtime_error("Failed to construct TileLayerRenderer: renderer, ResourceManager or tile graphics is nullptr");
+    }
+    if (map_size_.x <= 0 || map_size_.y <= 0 || tile_size_.x <= 0 || tile_size_.y <= 0)
+    {
+        throw std::runtime_error("Failed to construct TileLayerRenderer: invalid map or tile size");
+    }
+    if (gids_.size() != static_cast<size_t>(map_size_.x) * map_size_.y)
+    {
+        throw std::runtime_error("Failed to construct TileLayerRenderer: tile data doesn't match map size");
+    }
+
+    chunk_tiles_ = glm::max(glm::ivec2(chunk_pixels_ / tile_size_.x, chunk_pixels_ / tile_size_.y), glm::ivec2(1, 1));
+    chunk_count_ = {(map_size_.x + chunk_tiles_.x - 1) / chunk_tiles_.x, (map_size_.y + chunk_tiles_.y - 1) / chunk_tiles_.y};
+    chunks_.resize(static_cast<size_t>(chunk_count_.x) * chunk_count_.y);
+
+    const glm::vec2& max_tile = tile_graphics_->getMaxTileSize();
+    overhang_tiles_ = {
+        std::max(0, static_cast<int>(glm::ceil(max_tile.x / tile_size_.x)) - 1),
+        std::max(0, static_cast<int>(glm::ceil(max_tile.y / tile_size_.y)) - 1),
+    };
+
+    spdlog::trace("TileLayerRenderer constructed: {}x{} tiles in {}x{} chunks", map_size_.x, map_size_.y, chunk_count_.x, chunk_count_.y);
+}
+
+uint32_t TileLayerRenderer::getTile(int x, int y) const
+{
+    if (x < 0 || y < 0 || x >= map_size_.x || y >= map_size_.y)
+        return 0;
+    return gids_[static_cast<size_t>(y) * map_size_.x + x];
+}
+
+void TileLayerRenderer::setTile(int x, int y, uint32_t gid)
+{
+    if (x < 0 || y < 0 || x >= map_size_.x || y >= map_size_.y)
+    {
+        spdlog::warn("TileLayerRenderer: setTile out of range ({}, {})", x, y);
+        return;
+    }
+
+    uint32_t& cell = gids_[static_cast<size_t>(y) * map_size_.x + x];
+    if (cell == gid)
+        return;
+
+    markDirty(x, y, cell);
+    markDirty(x, y, gid);
+    cell = gid;
+}
+
+void TileLayerRenderer::bake()
+{
+    for (int cy = 0; cy < chunk_count_.y; ++cy)
+    {
+        for (int cx = 0; cx < chunk_count_.x; ++cx)
+        {
+            Chunk& chunk = chunks_[static_cast<size_t>(cy) * chunk_count_.x + cx];
+            if (chunk.dirty)
+            {
+                bakeChunk(cx, cy, chunk);
+            }
+        }
+    }
+}
+
+void TileLayerRenderer::invalidate()
+{
+    for (auto& chunk : chunks_)
+    {
+        chunk.dirty = true;
+    }
+}
+
+void TileLayerRenderer::draw(const Camera& camera)
+{
+    bake();
+
+    last_drawn_chunks_ = 0;
+    const glm::vec2 chunk_size = glm::vec2(chunk_tiles_ * tile_size_);
+    const glm::vec2 view_min = camera.getPosition() - offset_;
+    const glm::vec2 view_max = view_min + camera.getViewportSize();
+
+    glm::ivec2 first = glm::max(glm::ivec2(glm::floor(view_min / chunk_size)), glm::ivec2(0, 0));
+    glm::ivec2 last = glm::min(glm::ivec2(glm::floor(view_max / chunk_size)), chunk_count_ - glm::ivec2(1, 1));
+
+    for (int cy = first.y; cy <= last.y; ++cy)
+    {
+        for (int cx = first.x; cx <= last.x; ++cx)
+        {
+            const Chunk& chunk = chunks_[static_cast<size_t>(cy) * chunk_count_.x + cx];
+            if (chunk.empty)
+                continue;
+
+            glm::vec2 screen_pos = camera.worldToScreen(offset_ + glm::vec2(cx, cy) * chunk_size);
+            SDL_FRect src_rect = {0.0f, 0.0f, chunk_size.x, chunk_size.y};
+            SDL_FRect dest_rect = {screen_pos.x, screen_pos.y, chunk_size.x, chunk_size.y};
+            renderer_->drawTexture(chunk.texture.get(), src_rect, dest_rect);
+            ++last_drawn_chunks_;
+        }
+    }
+}
+
+void TileLayerRenderer::bakeChunk(int chunk_x, int chunk_y, Chunk& chunk)
+{
+    chunk.dirty = false;
+    SDL_Renderer* sdl_renderer = renderer_->getSDLRenderer();
+    const glm::ivec2 chunk_size = chunk_tiles_ * tile_size_;
+    const glm::ivec2 chunk_origin = glm::ivec2(chunk_x, chunk_y) * chunk_size;
+
+    if (!chunk.texture)
+    {
+        SDL_Texture* texture = SDL_CreateTexture(sdl_renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_TARGET, chunk_size.x, chunk_size.y);
+        if (texture == nullptr)
+        {
+            spdlog::error("TileLayerRenderer: failed to create chunk texture. SDL error: {}", SDL_GetError());
+            chunk.empty = true;
+            return;
+        }
+        // alpha blended tiles leave premultiplied color in the target
+        SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND_PREMULTIPLIED);
+        SDL_SetTextureScaleMode(texture, SDL_SCALEMODE_NEAREST);
+        chunk.texture.reset(texture);
+    }
+
+    // quads already batched belong to the current target, queued commands are drawn later at flush
+    renderer_->flushBatch();
+    SDL_Texture* previous_target = SDL_GetRenderTarget(sdl_renderer);
+    if (!SDL_SetRenderTarget(sdl_renderer, chunk.texture.get()))
+    {
+        spdlog::error("TileLayerRenderer: failed to set chunk render target. SDL error: {}", SDL_GetError());
+        return;
+    }
+
+    Uint8 r, g, b, a;
+    SDL_GetRenderDrawColor(sdl_renderer, &r, &g, &b, &a);
+    SDL_SetRenderDrawColor(sdl_renderer, 0, 0, 0, 0);
+    SDL_RenderClear(sdl_renderer);
+    SDL_SetRenderDrawColor(sdl_renderer, r, g, b, a);
+
+    // tiles left of / below the chunk may reach into it with an oversized image
+    glm::ivec2 first = glm::max(glm::ivec2(chunk_x, chunk_y) * chunk_tiles_ - glm::ivec2(overhang_tiles_.x, 0), glm::ivec2(0, 0));
+    glm::ivec2 last = glm::min(glm::ivec2(chunk_x + 1, chunk_y + 1) * chunk_tiles_ - glm::ivec2(1, 1) + glm::ivec2(0, overhang_tiles_.y), map_size_ - glm::ivec2(1, 1));
+
+    SDL_Texture* batch_texture = nullptr;
+    glm::vec2 texture_size = {1.0f, 1.0f};
+    bool drew_any = false;
+
+    for (int y = first.y; y <= last.y; ++y)
+    {
+        for (int x = first.x; x <= last.x; ++x)
+        {
+            uint32_t gid = gids_[static_cast<size_t>(y) * map_size_.x + x];
+            if ((gid & TILE_GID_MASK) == 0)
+                continue;
+
+            const TileGraphic* graphic = tile_graphics_->find(gid);
+            if (graphic == nullptr)
+                continue;
+
+            auto region = resource_manager_->getTextureRegion(graphic->texture_id);
+            if (region.texture == nullptr)
+                continue;
+
+            if (region.texture != batch_texture)
+            {
+                flushBakeBatch(batch_texture);
+                batch_texture = region.texture;
+                texture_size = {region.texture_width, region.texture_height};
+            }
+
+            const SDL_FRect& src = graphic->source_rect;
+            // Tiled anchors tile images to the bottom-left corner of their cell
+            glm::vec2 pos = glm::vec2(x * tile_size_.x, (y + 1) * tile_size_.y - src.h) - glm::vec2(chunk_origin);
+
+            float u0 = (region.rect.x + src.x) / texture_size.x;
+            float v0 = (region.rect.y + src.y) / texture_size.y;
+            float u1 = (region.rect.x + src.x + src.w) / texture_size.x;
+            float v1 = (region.rect.y + src.y + src.h) / texture_size.y;
+
+            // corner order: top-left, top-right, bottom-right, bottom-left
+            SDL_FPoint uvs[4] = {{u0, v0}, {u1, v0}, {u1, v1}, {u0, v1}};
+            if (gid & TILE_FLIPPED_DIAGONALLY)
+            {
+                std::swap(uvs[1], uvs[3]);
+            }
+            if (gid & TILE_FLIPPED_HORIZONTALLY)
+            {
+                std::swap(uvs[0], uvs[1]);
+                std::swap(uvs[3], uvs[2]);
+            }
+            if (gid & TILE_FLIPPED_VERTICALLY)
+            {
+                std::swap(uvs[0], uvs[3]);
+                std::swap(uvs[1], uvs[2]);
+            }
+
+            const SDL_FPoint corners[4] = {{pos.x, pos.y}, {pos.x + src.w, pos.y}, {pos.x + src.w, pos.y + src.h}, {pos.x, pos.y + src.h}};
+            int base = static_cast<int>(bake_vertices_.size());
+            for (int i = 0; i < 4; ++i)
+            {
+                bake_vertices_.push_back({corners[i], {1.0f, 1.0f, 1.0f, 1.0f}, uvs[i]});
+            }
+            for (int index : {0, 1, 2, 0, 2, 3})
+            {
+                bake_indices_.push_back(base + index);
+            }
+            drew_any = true;
+        }
+    }
+    flushBakeBatch(batch_texture);
+
+    SDL_SetRenderTarget(sdl_renderer, previous_target);
+    ++total_bakes_;
+
+    chunk.empty = !drew_any;
+    if (chunk.empty)
+    {
+        chunk.texture.reset();
+    }
+}
+
+void TileLayerRenderer::markDirty(int x, int y, uint32_t gid)
+{
+    glm::vec2 size = glm::vec2(tile_size_);
+    if (const TileGraphic* graphic = tile_graphics_->find(gid))
+    {
+        size = {graphic->source_rect.w, graphic->source_rect.h};
+    }
+
+    const glm::vec2 chunk_size = glm::vec2(chunk_tiles_ * tile_size_);
+    glm::vec2 min = glm::vec2(x * tile_size_.x, (y + 1) * tile_size_.y - size.y);
+    glm::vec2 max = min + size - glm::vec2(1.0f, 1.0f);
+
+    glm::ivec2 first = glm::max(glm::ivec2(glm::floor(min / chunk_size)), glm::ivec2(0, 0));
+    glm::ivec2 last = glm::min(glm::ivec2(glm::floor(max / chunk_size)), chunk_count_ - glm::ivec2(1, 1));
+    for (int cy = first.y; cy <= last.y; ++cy)
+    {
+        for (int cx = first.x; cx <= last.x; ++cx)
+        {
+            chunks_[static_cast<size_t>(cy) * chunk_count_.x + cx].dirty = true;
+        }
+    }
+}
+
+void TileLayerRenderer::flushBakeBatch(SDL_Texture* texture)
+{
+    if (texture != nullptr && !bake_indices_.empty())
+    {
+        if (!SDL_RenderGeometry(renderer_->getSDLRenderer(), texture, bake_vertices_.data(), static_cast<int>(bake_vertices_.size()), bake_indices_.data(), static_cast<int>(bake_indices_.size())))
+        {
+            spdlog::error("TileLayerRenderer: SDL_RenderGeometry failed while baking. SDL error: {}", SDL_GetError());
+        }
+    }
+    bake_vertices_.clear();
+    bake_indices_.clear();
+}
+
+} // namespace engine::render
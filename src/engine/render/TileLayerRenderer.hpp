@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <SDL3/SDL_render.h>
+#include <glm/vec2.hpp>
+
+namespace engine::resource
+{
+class ResourceManager;
+}
+
+namespace engine::render
+{
+
+class Camera;
+class Renderer;
+class TileGraphicTable;
+
+// Bakes a static tile layer into fixed-size chunk textures and blits only the chunks overlapping the camera.
+class TileLayerRenderer final
+{
+private:
+    struct SDLTextureDeleter
+    {
+        void operator()(SDL_Texture* texture) const
+        {
+            if (texture)
+            {
+                SDL_DestroyTexture(texture);
+            }
+        }
+    };
+
+    struct Chunk
+    {
+        std::unique_ptr<SDL_Texture, SDLTextureDeleter> texture;
+        bool dirty = true;
+        bool empty = true;
+    };
+
+    Renderer* renderer_ = nullptr;
+    engine::resource::ResourceManager* resource_manager_ = nullptr;
+    const TileGraphicTable* tile_graphics_ = nullptr;
+
+    glm::ivec2 map_size_;  // in tiles
+    glm::ivec2 tile_size_; // in pixels
+    glm::vec2 offset_;
+    int chunk_pixels_ = 256;
+    glm::ivec2 chunk_tiles_;
+    glm::ivec2 chunk_count_;
+    // how far a tile image may reach beyond its cell (image collection tiles are anchored bottom-left)
+    glm::ivec2 overhang_tiles_;
+
+    std::vector<uint32_t> gids_;
+    std::vector<Chunk> chunks_;
+
+    std::vector<SDL_Vertex> bake_vertices_;
+    std::vector<int> bake_indices_;
+
+    int last_drawn_chunks_ = 0;
+    int total_bakes_ = 0;
+
+public:
+    TileLayerRenderer(Renderer* renderer, engine::resource::ResourceManager* resource_manager, const TileGraphicTable* tile_graphics, const glm::ivec2& map_size, const glm::ivec2& tile_size, std::vector<uint32_t> gids, int chunk_pixels = 256, const glm::vec2& offset = {0.0f, 0.0f});
+
+    TileLayerRenderer(const TileLayerRenderer&) = delete;
+    TileLayerRenderer& operator=(const TileLayerRenderer&) = delete;
+    TileLayerRenderer(TileLayerRenderer&&) = delete;
+    TileLayerRenderer& operator=(TileLayerRenderer&&) = delete;
+
+    uint32_t getTile(int x, int y) const;
+    // marks every chunk the old and new tile image touch for rebaking
+    void setTile(int x, int y, uint32_t gid);
+
+    // rebakes dirty chunks, draw() does this lazily as well
+    void bake();
+    // render target contents can be lost (SDL_EVENT_RENDER_TARGETS_RESET), force a full rebake
+    void invalidate();
+    void draw(const Camera& camera);
+
+    int getLastDrawnChunks() const { return last_drawn_chunks_; }
+    int getTotalBakes() const { return total_bakes_; }
+
+private:
+    void bakeChunk(int chunk_x, int chunk_y, Chunk& chunk);
+    void markDirty(int x, int y, uint32_t gid);
+    void flushBakeBatch(SDL_Texture* texture);
+};
+
+} // namespace engine::render
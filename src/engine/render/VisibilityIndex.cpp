@@ -0,0 +1,55 @@
+#include "VisibilityIndex.hpp"
+
+#include "engine/render/Camera.hpp"
+
+namespace engine::render
+{
+
+VisibilityIndex::VisibilityIndex(float static_cell_size, float dynamic_cell_size)
+    : static_grid_(static_cell_size)
+    , dynamic_grid_(dynamic_cell_size)
+{
+}
+
+SpatialGrid::ObjectId VisibilityIndex::addStatic(const engine::utils::Rect& bounds, uint32_t user_data)
+{
+    return static_grid_.insert(bounds, user_data);
+}
+
+void VisibilityIndex::removeStatic(SpatialGrid::ObjectId id)
+{
+    static_grid_.remove(id);
+}
+
+SpatialGrid::ObjectId VisibilityIndex::addDynamic(const engine::utils::Rect& bounds, uint32_t user_data)
+{
+    return dynamic_grid_.insert(bounds, user_data);
+}
+
+void VisibilityIndex::moveDynamic(SpatialGrid::ObjectId id, const engine::utils::Rect& bounds)
+{
+    dynamic_grid_.update(id, bounds);
+}
+
+void VisibilityIndex::removeDynamic(SpatialGrid::ObjectId id)
+{
+    dynamic_grid_.remove(id);
+}
+
+void VisibilityIndex::clear()
+{
+    static_grid_.clear();
+    dynamic_grid_.clear();
+    visible_.clear();
+}
+
+const std::vector<uint32_t>& VisibilityIndex::queryVisible(const Camera& camera, float margin)
+{
+    visible_.clear();
+    engine::utils::Rect view = camera.getViewRect(margin);
+    static_grid_.query(view, visible_);
+    dynamic_grid_.query(view, visible_);
+    return visible_;
+}
+
+} // namespace engine::render
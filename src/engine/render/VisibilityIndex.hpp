@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "engine/render/SpatialGrid.hpp"
+
+namespace engine::render
+{
+
+class Camera;
+
+// World sprites split into a static grid (built once at level load) and a dynamic grid (moved every tick).
+class VisibilityIndex final
+{
+private:
+    SpatialGrid static_grid_;
+    SpatialGrid dynamic_grid_;
+    std::vector<uint32_t> visible_;
+
+public:
+    explicit VisibilityIndex(float static_cell_size = 256.0f, float dynamic_cell_size = 128.0f);
+
+    VisibilityIndex(const VisibilityIndex&) = delete;
+    VisibilityIndex& operator=(const VisibilityIndex&) = delete;
+    VisibilityIndex(VisibilityIndex&&) = delete;
+    VisibilityIndex& operator=(VisibilityIndex&&) = delete;
+
+    SpatialGrid::ObjectId addStatic(const engine::utils::Rect& bounds, uint32_t user_data);
+    void removeStatic(SpatialGrid::ObjectId id);
+
+    SpatialGrid::ObjectId addDynamic(const engine::utils::Rect& bounds, uint32_t user_data);
+    void moveDynamic(SpatialGrid::ObjectId id, const engine::utils::Rect& bounds);
+    void removeDynamic(SpatialGrid::ObjectId id);
+
+    void clear();
+
+    // user_data of static then dynamic objects overlapping the camera view grown by margin, valid until the next query
+    const std::vector<uint32_t>& queryVisible(const Camera& camera, float margin = 32.0f);
+};
+
+} // namespace engine::render
@@ -0,0 +1,107 @@
+#include "AssetArchive.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include <SDL3/SDL_iostream.h>
+#include <spdlog/spdlog.h>
+
+namespace engine::resource
+{
+
+AssetArchive::AssetArchive(std::string_view path)
+{
+    if (!file_.open(path))
+    {
+        throw std::runtime_error("AssetArchive construction failed: cannot map " + std::string(path));
+    }
+
+    const std::byte* data = file_.getData();
+    size_t size = file_.getSize();
+
+    ArchiveHeader header;
+    if (size < sizeof(header))
+    {
+        throw std::runtime_error("AssetArchive construction failed: " + std::string(path) + " is truncated");
+    }
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, ARCHIVE_MAGIC, sizeof(ARCHIVE_MAGIC)) != 0 || header.version != ARCHIVE_VERSION)
+    {
+        throw std::runtime_error("AssetArchive construction failed: " + std::string(path) + " is not a version " + std::to_string(ARCHIVE_VERSION) + " archive");
+    }
+    if (header.toc_offset % alignof(ArchiveEntry) != 0 || header.toc_offset > size || (size - header.toc_offset) / sizeof(ArchiveEntry) < header.entry_count)
+    {
+        throw std::runtime_error("AssetArchive construction failed: " + std::string(path) + " has a corrupt table of contents");
+    }
+
+    entries_ = {reinterpret_cast<const ArchiveEntry*>(data + header.toc_offset), header.entry_count};
+    for (const auto& entry : entries_)
+    {
+        if (entry.offset > size || entry.size > size - entry.offset)
+        {
+            throw std::runtime_error("AssetArchive construction failed: " + std::string(path) + " has an entry past the end of the file");
+        }
+    }
+    freshness_ = std::make_unique<std::atomic<uint8_t>[]>(entries_.size());
+
+    spdlog::info("AssetArchive: mapped {} ({} entries, {} KB)", path, entries_.size(), size / 1024);
+}
+
+const ArchiveEntry* AssetArchive::find(AssetId id) const
+{
+    auto it = std::lower_bound(entries_.begin(), entries_.end(), id.getValue(), [](const ArchiveEntry& entry, uint64_t value) { return entry.id < value; });
+    if (it == entries_.end() || it->id != id.getValue())
+    {
+        return nullptr;
+    }
+    return isCurrent(static_cast<size_t>(it - entries_.begin()), id) ? &*it : nullptr;
+}
+
+bool AssetArchive::isCurrent(size_t index, AssetId id) const
+{
+    uint8_t state = freshness_[index].load(std::memory_order_relaxed);
+    if (state != 0)
+    {
+        return state == 1;
+    }
+
+    // two threads may check the same entry at once, they come to the same answer
+    const ArchiveEntry& entry = entries_[index];
+    std::string path = AssetId::getPath(id);
+    int64_t mtime = 0;
+    uint64_t size = 0;
+    // ids that were never interned have no path to check, the packed copy is all there is
+    bool changed = !path.empty() && getArchiveSourceStamp(std::filesystem::path(path), mtime, size) && (mtime != entry.source_mtime || size != entry.source_size);
+    if (changed)
+    {
+        spdlog::info("AssetArchive: {} changed since it was packed, using the loose file", path);
+    }
+    freshness_[index].store(changed ? 2 : 1, std::memory_order_relaxed);
+    return !changed;
+}
+
+std::span<const std::byte> AssetArchive::getData(const ArchiveEntry& entry) const
+{
+    return {file_.getData() + entry.offset, static_cast<size_t>(entry.size)};
+}
+
+SDL_IOStream* AssetArchive::openIO(AssetId id) const
+{
+    const ArchiveEntry* entry = find(id);
+    if (entry == nullptr || entry->type != ArchiveEntryType::BLOB)
+    {
+        return nullptr;
+    }
+
+    auto data = getData(*entry);
+    SDL_IOStream* io = SDL_IOFromConstMem(data.data(), data.size());
+    if (io == nullptr)
+    {
+        spdlog::error("AssetArchive: failed to open stream for {}. SDL error: {}", AssetId::toString(id), SDL_GetError());
+    }
+    return io;
+}
+
+} // namespace engine::resource
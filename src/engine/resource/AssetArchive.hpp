@@ -0,0 +1,105 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <string_view>
+
+#include "engine/resource/AssetId.hpp"
+#include "engine/utils/MappedFile.hpp"
+
+struct SDL_IOStream;
+
+namespace engine::resource
+{
+
+// On-disk layout, written by tools/asset_packer in native (little endian) byte order:
+//   ArchiveHeader | payloads, each ARCHIVE_ALIGNMENT aligned | ArchiveEntry[entry_count] sorted by id
+inline constexpr char ARCHIVE_MAGIC[8] = {'I', 'S', 'L', 'P', 'A', 'K', '0', '1'};
+inline constexpr uint32_t ARCHIVE_VERSION = 2;
+inline constexpr uint64_t ARCHIVE_ALIGNMENT = 64;
+
+enum class ArchiveEntryType : uint32_t
+{
+    BLOB = 0,   // file copied as is (audio, fonts, maps)
+    RGBA32 = 1, // decoded image, tightly packed SDL_PIXELFORMAT_RGBA32 rows
+};
+
+struct ArchiveHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t entry_count;
+    uint64_t toc_offset;
+};
+static_assert(sizeof(ArchiveHeader) == 24);
+
+struct ArchiveEntry
+{
+    uint64_t id; // AssetId of the path relative to the project root
+    ArchiveEntryType type;
+    uint32_t width;
+    uint32_t height;
+    uint32_t reserved;
+    uint64_t offset;
+    uint64_t size;
+    // the source file when it was packed, see getArchiveSourceStamp()
+    int64_t source_mtime;
+    uint64_t source_size;
+};
+static_assert(sizeof(ArchiveEntry) == 56);
+
+// Modification time (nanoseconds on the std::filesystem clock) and size of a source file, false if it can't be
+// read. An entry whose loose file no longer matches its stamp is out of date.
+inline bool getArchiveSourceStamp(const std::filesystem::path& path, int64_t& mtime, uint64_t& size)
+{
+    std::error_code error;
+    auto time = std::filesystem::last_write_time(path, error);
+    if (error)
+        return false;
+    auto bytes = std::filesystem::file_size(path, error);
+    if (error)
+        return false;
+    mtime = std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+    size = static_cast<uint64_t>(bytes);
+    return true;
+}
+
+// Read-only view of a packed archive. Payloads are served straight out of the mapping, so everything handed
+// out stays valid for the archive's lifetime. Safe to read from any thread. An entry whose loose file was
+// modified after packing is treated as not packed, so edited assets show up without repacking; the loose file is
+// checked once, on the entry's first lookup, later lookups are only the binary search.
+class AssetArchive final
+{
+private:
+    engine::utils::MappedFile file_;
+    std::span<const ArchiveEntry> entries_;
+    // per entry: 0 not checked yet, 1 packed copy is current, 2 loose file changed
+    std::unique_ptr<std::atomic<uint8_t>[]> freshness_;
+
+public:
+    explicit AssetArchive(std::string_view path);
+
+    AssetArchive(const AssetArchive&) = delete;
+    AssetArchive& operator=(const AssetArchive&) = delete;
+    AssetArchive(AssetArchive&&) = delete;
+    AssetArchive& operator=(AssetArchive&&) = delete;
+
+    // nullptr when the asset is not packed, or its loose file had changed when it was first looked up
+    const ArchiveEntry* find(AssetId id) const;
+    std::span<const std::byte> getData(const ArchiveEntry& entry) const;
+    // read-only stream over a BLOB payload, nullptr when the asset is not packed
+    SDL_IOStream* openIO(AssetId id) const;
+
+    size_t getEntryCount() const { return entries_.size(); }
+    size_t getSize() const { return file_.getSize(); }
+
+private:
+    bool isCurrent(size_t index, AssetId id) const;
+};
+
+} // namespace engine::resource
@@ -0,0 +1,86 @@
+#include "AssetId.hpp"
+
+#include <mutex>
+#include <unordered_map>
+
+#include <spdlog/fmt/fmt.h>
+#include <spdlog/spdlog.h>
+
+namespace engine::resource
+{
+
+namespace
+{
+
+// the same folding hash() applies, so two spellings of one path are not reported as a collision
+std::string normalizePath(std::string_view path)
+{
+#ifdef SOURCE_DIR
+    constexpr std::string_view source_dir = SOURCE_DIR;
+    if (path.starts_with(source_dir))
+    {
+        path.remove_prefix(source_dir.size());
+    }
+#endif
+    std::string normalized;
+    normalized.reserve(path.size());
+    for (char c : path)
+    {
+        if (c == '\\')
+        {
+            c = '/';
+        }
+        if (c == '/' && !normalized.empty() && normalized.back() == '/')
+            continue;
+        normalized.push_back(c);
+    }
+    return normalized;
+}
+
+struct Registry
+{
+    std::mutex mutex;
+    std::unordered_map<AssetId, std::string, AssetIdHash> paths;
+};
+
+Registry& registry()
+{
+    static Registry instance;
+    return instance;
+}
+
+} // namespace
+
+AssetId AssetId::intern(std::string_view path)
+{
+    AssetId id = fromPath(path);
+
+    auto& reg = registry();
+    std::lock_guard lock(reg.mutex);
+    auto [it, inserted] = reg.paths.try_emplace(id, path);
+    if (!inserted && it->second != path && normalizePath(it->second) != normalizePath(path))
+    {
+        spdlog::error("AssetId: hash collision between {} and {} ({:016x})", it->second, path, id.value_);
+        return {};
+    }
+    return id;
+}
+
+std::string AssetId::getPath(AssetId id)
+{
+    auto& reg = registry();
+    std::lock_guard lock(reg.mutex);
+    if (auto it = reg.paths.find(id); it != reg.paths.end())
+    {
+        return it->second;
+    }
+    return {};
+}
+
+std::string AssetId::toString(AssetId id)
+{
+    std::string path = getPath(id);
+    return path.empty() ? fmt::format("#{:016x}", id.value_) : path;
+}
+
+} // namespace engine::resource
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace engine::resource
+{
+
+// 64-bit FNV-1a hash of a normalized asset path. The SOURCE_DIR prefix is dropped and separators are folded,
+// so "C:\\game\\assets\\a.png" and SOURCE_DIR "assets/a.png" name the same asset.
+class AssetId final
+{
+private:
+    uint64_t value_ = 0;
+
+public:
+    constexpr AssetId() = default;
+
+    // literal paths hash at compile time: AssetId(SOURCE_DIR "assets/textures/Items/gem.png")
+    template <size_t N>
+    consteval AssetId(const char (&path)[N])
+        : value_(hash(std::string_view(path, N - 1)))
+    {
+    }
+
+    // runtime paths, hashes in place without allocating
+    static constexpr AssetId fromPath(std::string_view path)
+    {
+        AssetId id;
+        id.value_ = hash(path);
+        return id;
+    }
+
+    // Hashes the path and records it so managers can load by id and logs can name it. Returns an invalid id
+    // if a different path already owns the hash.
+    static AssetId intern(std::string_view path);
+    // path the id was interned with, empty if it never was
+    static std::string getPath(AssetId id);
+    // for logs: the interned path, or the raw hash
+    static std::string toString(AssetId id);
+
+    constexpr uint64_t getValue() const { return value_; }
+    constexpr bool isValid() const { return value_ != 0; }
+    constexpr bool operator==(const AssetId&) const = default;
+
+    static constexpr uint64_t hash(std::string_view path)
+    {
+#ifdef SOURCE_DIR
+        constexpr std::string_view source_dir = SOURCE_DIR;
+        if (path.starts_with(source_dir))
+        {
+            path.remove_prefix(source_dir.size());
+        }
+#endif
+        uint64_t h = 14695981039346656037ull;
+        char previous = '\0';
+        for (char c : path)
+        {
+            if (c == '\\')
+            {
+                c = '/';
+            }
+            if (c == '/' && previous == '/')
+                continue;
+            h ^= static_cast<unsigned char>(c);
+            h *= 1099511628211ull;
+            previous = c;
+        }
+        // 0 is reserved for the invalid id
+        return h != 0 ? h : 1;
+    }
+};
+
+struct AssetIdHash
+{
+    // already uniformly distributed
+    std::size_t operator()(AssetId id) const { return static_cast<std::size_t>(id.getValue()); }
+};
+
+} // namespace engine::resource
@@ -1,12 +1,51 @@
 #include "AudioManager.hpp"
 
+#include <fstream>
+#include <future>
+#include <iterator>
+#include <span>
+#include <utility>
+
 #include <spdlog/spdlog.h>
 #include <SDL3_mixer/SDL_mixer.h>
 
+#include "engine/core/ThreadPool.hpp"
+#include "engine/resource/AssetArchive.hpp"
+#include "engine/resource/PCMCache.hpp"
+
 namespace engine::resource
 {
 
-AudioManager::AudioManager()
+namespace
+{
+
+MIX_Audio* loadAudio(MIX_Mixer* mixer, const AssetArchive* archive, const PCMCache* cache, AssetId id, const std::string& path, bool predecode)
+{
+    if (cache && predecode)
+    {
+        if (const ArchiveEntry* entry = archive ? archive->find(id) : nullptr)
+        {
+            return cache->load(mixer, id, archive->getData(*entry));
+        }
+        // the cache is keyed by the source bytes, which are read once here and decoded from memory on a miss
+        if (std::ifstream file(path, std::ios::binary); file)
+        {
+            std::vector<char> source{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+            return cache->load(mixer, id, std::as_bytes(std::span(source)));
+        }
+    }
+
+    if (SDL_IOStream* io = archive ? archive->openIO(id) : nullptr)
+    {
+        return MIX_LoadAudio_IO(mixer, io, predecode, true);
+    }
+    return MIX_LoadAudio(mixer, path.c_str(), predecode);
+}
+
+} // namespace
+
+AudioManager::AudioManager(engine::core::ThreadPool* thread_pool)
+    : thread_pool_(thread_pool)
 {
     if (!MIX_Init())
     {
@@ -29,6 +68,11 @@ AudioManager::AudioManager()
         throw std::runtime_error(std::string("Failed to construct AudioManager: MIX_CreateMixer failed. SDL error: ") + SDL_GetError());
     }
     mixer_ = mixer;
+    // the mixer may not have granted the requested spec, cached PCM must match what it really plays
+    if (!MIX_GetMixerFormat(mixer_, &spec_))
+    {
+        spec_ = desiredSpec;
+    }
 
     spdlog::trace("AudioManager constructed");
 }
@@ -47,56 +91,146 @@ AudioManager::~AudioManager()
     spdlog::trace("AudioManager destroyed");
 }
 
-MIX_Audio* AudioManager::load(std::string_view file_path)
+bool AudioManager::setPCMCacheDirectory(std::string_view directory)
 {
-    if (auto it = audio_map_.find(std::string(file_path)); it != audio_map_.end())
+    pcm_cache_.reset();
+    if (directory.empty())
+    {
+        return true;
+    }
+
+    try
+    {
+        pcm_cache_ = std::make_unique<PCMCache>(directory, spec_);
+    }
+    catch (const std::exception& e)
+    {
+        spdlog::error("{}. Sounds will be decoded on every load", e.what());
+        return false;
+    }
+    spdlog::info("PCM cache for sounds at {} ({} Hz, {} channels)", directory, spec_.freq, spec_.channels);
+    return true;
+}
+
+MIX_Audio* AudioManager::load(std::string_view file_path, bool predecode)
+{
+    AssetId id = AssetId::intern(file_path);
+    if (!id.isValid())
+    {
+        return nullptr;
+    }
+
+    AudioMap& audio_map = getMap(predecode);
+    if (auto it = audio_map.find(id); it != audio_map.end())
     {
         spdlog::trace("Audio already loaded: {}", file_path);
         return it->second.get();
     }
 
-    MIX_Audio* audio = MIX_LoadAudio(mixer_, file_path.data(), true);
+    MIX_Audio* audio = loadAudio(mixer_, archive_, pcm_cache_.get(), id, std::string(file_path), predecode);
     if (audio == nullptr)
     {
         spdlog::error("Failed to load audio: {}. SDL_mixer error: {}", file_path, SDL_GetError());
         return nullptr;
     }
 
-    audio_map_.emplace(file_path, std::unique_ptr<MIX_Audio, SDLAudioDeleter>(audio));
-    spdlog::info("Loaded audio: {}", file_path);
+    audio_map.emplace(id, std::unique_ptr<MIX_Audio, SDLAudioDeleter>(audio));
+    spdlog::info("Loaded audio ({}): {}", predecode ? "predecoded" : "streamed", file_path);
     return audio;
 }
 
-MIX_Audio* AudioManager::get(std::string_view file_path)
+size_t AudioManager::preload(const std::vector<std::string>& file_paths)
 {
-    if (auto it = audio_map_.find(file_path.data()); it != audio_map_.end())
+    if (thread_pool_ == nullptr)
     {
-        return it->second.get();
+        size_t loaded = 0;
+        for (const auto& path : file_paths)
+        {
+            loaded += load(path) != nullptr ? 1 : 0;
+        }
+        return loaded;
     }
-    else
+
+    // MIX_LoadAudio may run on any thread; only the map is touched back here
+    std::vector<std::pair<AssetId, std::future<MIX_Audio*>>> decodes;
+    for (const auto& path : file_paths)
+    {
+        AssetId id = AssetId::intern(path);
+        if (!id.isValid() || sound_map_.contains(id))
+            continue;
+        decodes.emplace_back(id, thread_pool_->submit([mixer = mixer_, archive = archive_, cache = pcm_cache_.get(), id, path]() { return loadAudio(mixer, archive, cache, id, path, true); }));
+    }
+
+    for (auto& [id, decode] : decodes)
+    {
+        MIX_Audio* audio = decode.get();
+        if (audio == nullptr)
+        {
+            spdlog::error("Failed to preload audio: {}", AssetId::toString(id));
+            continue;
+        }
+        if (!sound_map_.emplace(id, std::unique_ptr<MIX_Audio, SDLAudioDeleter>(audio)).second)
+        {
+            // listed twice, the first decode won
+            MIX_DestroyAudio(audio);
+        }
+    }
+
+    size_t loaded = 0;
+    for (const auto& path : file_paths)
+    {
+        loaded += sound_map_.contains(AssetId::fromPath(path)) ? 1 : 0;
+    }
+    spdlog::info("Preloaded {}/{} sounds on {} threads", loaded, file_paths.size(), thread_pool_->getThreadCount());
+    if (pcm_cache_)
     {
-        spdlog::warn("Audio not found: {}. Attempting to load...", file_path);
-        return load(file_path);
+        spdlog::info("PCM cache: {} hits, {} misses so far", pcm_cache_->getHits(), pcm_cache_->getMisses());
     }
+    return loaded;
 }
 
-void AudioManager::unload(std::string_view file_path)
+MIX_Audio* AudioManager::get(AssetId id, bool predecode)
 {
+    AudioMap& audio_map = getMap(predecode);
+    if (auto it = audio_map.find(id); it != audio_map.end())
+    {
+        return it->second.get();
+    }
 
-    if (auto it = audio_map_.find(std::string(file_path)); it != audio_map_.end())
+    std::string path = AssetId::getPath(id);
+    if (path.empty())
     {
-        audio_map_.erase(it);
-        spdlog::info("Unloaded audio: {}", file_path);
+        spdlog::error("Audio not found and never loaded by path: {}", AssetId::toString(id));
+        return nullptr;
+    }
+    spdlog::warn("Audio not found: {}. Attempting to load...", path);
+    return load(path, predecode);
+}
+
+void AudioManager::unload(AssetId id, bool predecode)
+{
+    AudioMap& audio_map = getMap(predecode);
+    if (auto it = audio_map.find(id); it != audio_map.end())
+    {
+        audio_map.erase(it);
+        spdlog::info("Unloaded audio: {}", AssetId::toString(id));
     }
     else
     {
-        spdlog::warn("Audio not found, cannot unload: {}", file_path);
+        spdlog::warn("Audio not found, cannot unload: {}", AssetId::toString(id));
     }
 }
 
+void AudioManager::clear(bool predecode)
+{
+    getMap(predecode).clear();
+    spdlog::info("All {} unloaded", predecode ? "sounds" : "music");
+}
+
 void AudioManager::clear()
 {
-    audio_map_.clear();
+    sound_map_.clear();
+    music_map_.clear();
     spdlog::info("All audio resources unloaded");
 }
 
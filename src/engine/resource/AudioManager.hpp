@@ -4,12 +4,23 @@
 #include <string>
 #include <string_view>
 #include <unordered_map>
+#include <vector>
 
 #include <SDL3_mixer/SDL_mixer.h>
 
+#include "engine/resource/AssetId.hpp"
+
+namespace engine::core
+{
+class ThreadPool;
+}
+
 namespace engine::resource
 {
 
+class AssetArchive;
+class PCMCache;
+
 class AudioManager final
 {
     friend class ResourceManager;
@@ -27,10 +38,17 @@ private:
     };
 
     MIX_Mixer* mixer_ = nullptr;
-    std::unordered_map<std::string, std::unique_ptr<MIX_Audio, SDLAudioDeleter>> audio_map_;
+    SDL_AudioSpec spec_;
+    engine::core::ThreadPool* thread_pool_ = nullptr;
+    const AssetArchive* archive_ = nullptr;
+    std::unique_ptr<PCMCache> pcm_cache_;
+    using AudioMap = std::unordered_map<AssetId, std::unique_ptr<MIX_Audio, SDLAudioDeleter>, AssetIdHash>;
+    // predecoded and streamed audio are kept apart, the same file may be loaded both ways
+    AudioMap sound_map_;
+    AudioMap music_map_;
 
 public:
-    AudioManager();
+    explicit AudioManager(engine::core::ThreadPool* thread_pool = nullptr);
     ~AudioManager();
 
     AudioManager(const AudioManager&) = delete;
@@ -39,12 +57,25 @@ public:
     AudioManager& operator=(AudioManager&&) = delete;
 
 private:
-    MIX_Audio* load(std::string_view file_path);
-    MIX_Audio* get(std::string_view file_path);
-    void unload(std::string_view file_path);
+    // packed files are read from the archive mapping, the rest from disk
+    void setArchive(const AssetArchive* archive) { archive_ = archive; }
+    // predecoded sounds are kept there as PCM in the mixer format for later runs, empty disables the cache
+    bool setPCMCacheDirectory(std::string_view directory);
+
+    // predecode keeps the whole file as PCM (short effects); otherwise it is decoded while playing (music)
+    MIX_Audio* load(std::string_view file_path, bool predecode = true);
+    // predecodes the files in parallel on the worker pool, returns how many are loaded afterwards
+    size_t preload(const std::vector<std::string>& file_paths);
+    // a miss loads from the path the id was interned with
+    MIX_Audio* get(AssetId id, bool predecode = true);
+    void unload(AssetId id, bool predecode = true);
+    void clear(bool predecode);
     void clear();
 
     // void stop();
+
+private:
+    AudioMap& getMap(bool predecode) { return predecode ? sound_map_ : music_map_; }
 };
 
 } // namespace engine::resource
\ No newline at end of file
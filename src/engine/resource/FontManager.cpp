@@ -4,6 +4,8 @@
 #include <spdlog/spdlog.h>
 #include <SDL3_ttf/SDL_ttf.h>
 
+#include "engine/resource/AssetArchive.hpp"
+
 namespace engine::resource
 {
 
@@ -36,7 +38,12 @@ TTF_Font* FontManager::load(std::string_view file_path, int font_size)
         return nullptr;
     }
 
-    FontKey key = {std::string(file_path), font_size};
+    AssetId id = AssetId::intern(file_path);
+    if (!id.isValid())
+    {
+        return nullptr;
+    }
+    FontKey key = {id, font_size};
 
     if (auto it = font_map_.find(key); it != font_map_.end())
     {
@@ -44,7 +51,8 @@ TTF_Font* FontManager::load(std::string_view file_path, int font_size)
         return it->second.get();
     }
 
-    TTF_Font* font = TTF_OpenFont(file_path.data(), font_size);
+    SDL_IOStream* io = archive_ ? archive_->openIO(id) : nullptr;
+    TTF_Font* font = io ? TTF_OpenFontIO(io, true, static_cast<float>(font_size)) : TTF_OpenFont(std::string(file_path).c_str(), font_size);
     if (!font)
     {
         spdlog::error("FontManager::load: Failed to load font. Path: {}, Size: {}, Reason: {}", file_path, font_size, SDL_GetError());
@@ -56,45 +64,41 @@ TTF_Font* FontManager::load(std::string_view file_path, int font_size)
     return font;
 }
 
-TTF_Font* FontManager::get(std::string_view file_path, int font_size)
+TTF_Font* FontManager::get(AssetId id, int font_size)
 {
-    if (file_path.empty() || font_size <= 0)
+    if (!id.isValid() || font_size <= 0)
     {
-        spdlog::error("FontManager::get: Invalid arguments. Path: {}, Size: {}", file_path, font_size);
+        spdlog::error("FontManager::get: Invalid arguments. Path: {}, Size: {}", AssetId::toString(id), font_size);
         return nullptr;
     }
 
-    FontKey key = {std::string(file_path), font_size};
-
-    if (auto it = font_map_.find(key); it != font_map_.end())
+    if (auto it = font_map_.find(FontKey{id, font_size}); it != font_map_.end())
     {
         return it->second.get();
     }
     else
     {
-        spdlog::warn("FontManager::get: Font not found. Path: {}, Size: {}", file_path, font_size);
+        spdlog::warn("FontManager::get: Font not found. Path: {}, Size: {}", AssetId::toString(id), font_size);
         return nullptr;
     }
 }
 
-void FontManager::unload(std::string_view file_path, int font_size)
+void FontManager::unload(AssetId id, int font_size)
 {
-    if (file_path.empty() || font_size <= 0)
+    if (!id.isValid() || font_size <= 0)
     {
-        spdlog::error("FontManager::unload: Invalid arguments. Path: {}, Size: {}", file_path, font_size);
+        spdlog::error("FontManager::unload: Invalid arguments. Path: {}, Size: {}", AssetId::toString(id), font_size);
         return;
     }
 
-    FontKey key = {std::string(file_path), font_size};
-
-    if (auto it = font_map_.find(key); it != font_map_.end())
+    if (auto it = font_map_.find(FontKey{id, font_size}); it != font_map_.end())
     {
         font_map_.erase(it);
-        spdlog::trace("FontManager::unload: Successfully unloaded font. Path: {}, Size: {}", file_path, font_size);
+        spdlog::trace("FontManager::unload: Successfully unloaded font. Path: {}, Size: {}", AssetId::toString(id), font_size);
     }
     else
     {
-        spdlog::warn("FontManager::unload: Font not found. Path: {}, Size: {}", file_path, font_size);
+        spdlog::warn("FontManager::unload: Font not found. Path: {}, Size: {}", AssetId::toString(id), font_size);
     }
 }
 
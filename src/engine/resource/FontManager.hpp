@@ -8,16 +8,20 @@
 
 #include <SDL3_ttf/SDL_ttf.h>
 
+#include "engine/resource/AssetId.hpp"
+
 namespace engine::resource
 {
 
+class AssetArchive;
+
 class FontManager final
 {
 
     friend class ResourceManager;
 
 private:
-    using FontKey = std::pair<std::string, int>;
+    using FontKey = std::pair<AssetId, int>;
     struct SDLFontDeleter
     {
         void operator()(TTF_Font* font) const
@@ -31,9 +35,10 @@ private:
 
     struct FontKeyHash
     {
-        std::size_t operator()(const FontKey& key) const { return std::hash<std::string>()(key.first) ^ std::hash<int>()(key.second); }
+        std::size_t operator()(const FontKey& key) const { return AssetIdHash()(key.first) ^ std::hash<int>()(key.second); }
     };
     std::unordered_map<FontKey, std::unique_ptr<TTF_Font, SDLFontDeleter>, FontKeyHash> font_map_;
+    const AssetArchive* archive_ = nullptr;
 
 public:
     FontManager();
@@ -45,9 +50,12 @@ public:
     FontManager& operator=(FontManager&&) = delete;
 
 private:
+    // packed fonts are read from the archive mapping, the rest from disk
+    void setArchive(const AssetArchive* archive) { archive_ = archive; }
+
     TTF_Font* load(std::string_view file_path, int font_size);
-    TTF_Font* get(std::string_view file_path, int font_size);
-    void unload(std::string_view file_path, int font_size);
+    TTF_Font* get(AssetId id, int font_size);
+    void unload(AssetId id, int font_size);
     void clear();
 };
 } // namespace engine::resource
\ No newline at end of file
@@ -0,0 +1,233 @@
+#include "LevelManifest.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+
+namespace engine::resource
+{
+
+namespace
+{
+constexpr int DEFAULT_FONT_SIZE = 16;
+
+std::string resolvePath(const std::string& base_dir, const std::string& path)
+{
+    return (std::filesystem::path(base_dir) / path).lexically_normal().generic_string();
+}
+
+bool hasExtension(std::string_view path, std::initializer_list<std::string_view> extensions)
+{
+    std::string extension = std::filesystem::path(path).extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return std::find(extensions.begin(), extensions.end(), extension) != extensions.end();
+}
+
+template <typename T>
+void sortUnique(std::vector<T>& values)
+{
+    std::sort(values.begin(), values.end());
+    values.erase(std::unique(values.begin(), values.end()), values.end());
+}
+} // namespace
+
+bool LevelManifest::build(std::string_view map_path)
+{
+    map_path_ = std::string(map_path);
+    textures_.clear();
+    sounds_.clear();
+    fonts_.clear();
+
+    std::ifstream file{std::filesystem::path(map_path)};
+    if (!file.is_open())
+    {
+        spdlog::error("LevelManifest: failed to open map {}", map_path);
+        return false;
+    }
+
+    try
+    {
+        nlohmann::json j;
+        file >> j;
+
+        const std::string base_dir = std::filesystem::path(map_path).parent_path().generic_string();
+        if (j.contains("properties"))
+        {
+            collectProperties(j["properties"]);
+        }
+        if (j.contains("layers"))
+        {
+            collectLayers(j["layers"], base_dir);
+        }
+
+        for (const auto& tileset : j.value("tilesets", nlohmann::json::array()))
+        {
+            if (!tileset.contains("source"))
+            {
+                collectTileset(tileset, base_dir);
+                continue;
+            }
+
+            std::string tileset_path = resolvePath(base_dir, tileset["source"].get<std::string>());
+            std::ifstream tileset_file{std::filesystem::path(tileset_path)};
+            if (!tileset_file.is_open())
+            {
+                spdlog::error("LevelManifest: failed to open tileset {}", tileset_path);
+                continue;
+            }
+            nlohmann::json tileset_json;
+            tileset_file >> tileset_json;
+            collectTileset(tileset_json, std::filesystem::path(tileset_path).parent_path().generic_string());
+        }
+    }
+    catch (const std::exception& e)
+    {
+        spdlog::error("LevelManifest: failed to parse {}. Error: {}", map_path, e.what());
+        return false;
+    }
+
+    finalize();
+    spdlog::info("LevelManifest: {} needs {} textures, {} sounds, {} fonts", map_path, textures_.size(), sounds_.size(), fonts_.size());
+    return true;
+}
+
+void LevelManifest::addTexture(std::string_view path)
+{
+    textures_.emplace_back(path);
+    finalize();
+}
+
+void LevelManifest::addSound(std::string_view path)
+{
+    sounds_.emplace_back(path);
+    finalize();
+}
+
+void LevelManifest::addFont(std::string_view path, int size)
+{
+    fonts_.push_back({std::string(path), size});
+    finalize();
+}
+
+void LevelManifest::collectTileset(const nlohmann::json& tileset, const std::string& base_dir)
+{
+    if (tileset.contains("image"))
+    {
+        textures_.push_back(resolvePath(base_dir, tileset["image"].get<std::string>()));
+    }
+    if (tileset.contains("properties"))
+    {
+        collectProperties(tileset["properties"]);
+    }
+    for (const auto& tile : tileset.value("tiles", nlohmann::json::array()))
+    {
+        if (tile.contains("image"))
+        {
+            textures_.push_back(resolvePath(base_dir, tile["image"].get<std::string>()));
+        }
+        if (tile.contains("properties"))
+        {
+            collectProperties(tile["properties"]);
+        }
+    }
+}
+
+void LevelManifest::collectLayers(const nlohmann::json& layers, const std::string& base_dir)
+{
+    for (const auto& layer : layers)
+    {
+        if (layer.contains("image") && !layer["image"].get<std::string>().empty())
+        {
+            textures_.push_back(resolvePath(base_dir, layer["image"].get<std::string>()));
+        }
+        if (layer.contains("properties"))
+        {
+            collectProperties(layer["properties"]);
+        }
+        for (const auto& object : layer.value("objects", nlohmann::json::array()))
+        {
+            if (object.contains("properties"))
+            {
+                collectProperties(object["properties"]);
+            }
+        }
+        if (layer.contains("layers"))
+        {
+            collectLayers(layer["layers"], base_dir);
+        }
+    }
+}
+
+void LevelManifest::collectProperties(const nlohmann::json& properties)
+{
+    int font_size = DEFAULT_FONT_SIZE;
+    for (const auto& property : properties)
+    {
+        if (property.value("name", "") == "font_size" && property.contains("value") && property["value"].is_number_integer())
+        {
+            font_size = property["value"].get<int>();
+        }
+    }
+
+    for (const auto& property : properties)
+    {
+        if (property.contains("value"))
+        {
+            collectValue(property["value"], font_size);
+        }
+    }
+}
+
+void LevelManifest::collectValue(const nlohmann::json& value, int font_size)
+{
+    if (value.is_object() || value.is_array())
+    {
+        for (const auto& element : value)
+        {
+            collectValue(element, font_size);
+        }
+        return;
+    }
+    if (!value.is_string())
+        return;
+
+    const auto& text = value.get_ref<const std::string&>();
+    if (!text.empty() && (text.front() == '{' || text.front() == '['))
+    {
+        // JSON carried in a string property, e.g. {"jump": "assets/audio/jump.mp3"}
+        auto nested = nlohmann::json::parse(text, nullptr, false);
+        if (!nested.is_discarded())
+        {
+            collectValue(nested, font_size);
+        }
+        return;
+    }
+
+    // property paths are written relative to the project root, like the rest of the game's asset paths
+    if (hasExtension(text, {".wav", ".mp3", ".ogg", ".flac"}))
+    {
+        sounds_.push_back(resolvePath(SOURCE_DIR, text));
+    }
+    else if (hasExtension(text, {".ttf", ".otf"}))
+    {
+        fonts_.push_back({resolvePath(SOURCE_DIR, text), font_size});
+    }
+    else if (hasExtension(text, {".png", ".jpg", ".jpeg", ".bmp"}))
+    {
+        textures_.push_back(resolvePath(SOURCE_DIR, text));
+    }
+}
+
+void LevelManifest::finalize()
+{
+    sortUnique(textures_);
+    sortUnique(sounds_);
+    sortUnique(fonts_);
+}
+
+} // namespace engine::resource
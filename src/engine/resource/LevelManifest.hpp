@@ -0,0 +1,54 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <nlohmann/json_fwd.hpp>
+
+namespace engine::resource
+{
+
+struct FontRef
+{
+    std::string path;
+    int size = 0;
+
+    bool operator==(const FontRef&) const = default;
+    auto operator<=>(const FontRef&) const = default;
+};
+
+// Every asset a Tiled map needs: layer images, tileset images, and audio/font paths found in custom properties
+// (also inside JSON-valued string properties such as actor "sound"). Lists are sorted and unique.
+class LevelManifest final
+{
+private:
+    std::string map_path_;
+    std::vector<std::string> textures_;
+    std::vector<std::string> sounds_;
+    std::vector<FontRef> fonts_;
+
+public:
+    LevelManifest() = default;
+
+    // walks the .tmj and its external tilesets; logs and returns false if the map can't be read
+    bool build(std::string_view map_path);
+    // assets the map can't know about, e.g. HUD fonts
+    void addTexture(std::string_view path);
+    void addSound(std::string_view path);
+    void addFont(std::string_view path, int size);
+
+    const std::string& getMapPath() const { return map_path_; }
+    const std::vector<std::string>& getTextures() const { return textures_; }
+    const std::vector<std::string>& getSounds() const { return sounds_; }
+    const std::vector<FontRef>& getFonts() const { return fonts_; }
+
+private:
+    void collectTileset(const nlohmann::json& tileset, const std::string& base_dir);
+    void collectLayers(const nlohmann::json& layers, const std::string& base_dir);
+    void collectProperties(const nlohmann::json& properties);
+    void collectValue(const nlohmann::json& value, int font_size);
+    void finalize();
+};
+
+} // namespace engine::resource
@@ -0,0 +1,180 @@
+#include "PCMCache.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+#include <SDL3/SDL_iostream.h>
+#include <SDL3/SDL_stdinc.h>
+#include <spdlog/fmt/fmt.h>
+#include <spdlog/spdlog.h>
+
+namespace engine::resource
+{
+
+namespace
+{
+
+constexpr char PCM_MAGIC[8] = {'I', 'S', 'L', 'P', 'C', 'M', '0', '1'};
+
+struct PCMHeader
+{
+    char magic[8];
+    uint64_t source_hash;
+    uint32_t format;
+    int32_t channels;
+    int32_t freq;
+    uint32_t reserved;
+    uint64_t data_size;
+};
+static_assert(sizeof(PCMHeader) == 40);
+
+uint64_t hashBytes(std::span<const std::byte> bytes)
+{
+    uint64_t h = 14695981039346656037ull;
+    for (std::byte b : bytes)
+    {
+        h ^= static_cast<uint64_t>(b);
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+} // namespace
+
+PCMCache::PCMCache(std::string_view directory, const SDL_AudioSpec& spec)
+    : directory_(directory)
+    , spec_(spec)
+{
+    std::error_code error;
+    std::filesystem::create_directories(std::filesystem::path(directory_), error);
+    if (error)
+    {
+        throw std::runtime_error("PCMCache construction failed: cannot create " + directory_ + ": " + error.message());
+    }
+    spdlog::trace("PCMCache constructed at {}", directory_);
+}
+
+MIX_Audio* PCMCache::load(MIX_Mixer* mixer, AssetId id, std::span<const std::byte> source) const
+{
+    uint64_t source_hash = hashBytes(source);
+    std::string cache_path = getCachePath(id);
+    if (MIX_Audio* audio = loadCached(mixer, cache_path, source_hash))
+    {
+        ++hits_;
+        return audio;
+    }
+    ++misses_;
+
+    MIX_AudioDecoder* decoder = MIX_CreateAudioDecoder_IO(SDL_IOFromConstMem(source.data(), source.size()), true, 0);
+    if (decoder == nullptr)
+    {
+        spdlog::error("PCMCache: failed to open decoder for {}. SDL error: {}", AssetId::toString(id), SDL_GetError());
+        return nullptr;
+    }
+
+    std::vector<std::byte> pcm;
+    constexpr int CHUNK_BYTES = 64 * 1024;
+    while (true)
+    {
+        size_t offset = pcm.size();
+        pcm.resize(offset + CHUNK_BYTES);
+        int decoded = MIX_DecodeAudio(decoder, pcm.data() + offset, CHUNK_BYTES, &spec_);
+        pcm.resize(offset + static_cast<size_t>(std::max(decoded, 0)));
+        if (decoded <= 0)
+        {
+            if (decoded < 0)
+            {
+                spdlog::error("PCMCache: failed to decode {}. SDL error: {}", AssetId::toString(id), SDL_GetError());
+                MIX_DestroyAudioDecoder(decoder);
+                return nullptr;
+            }
+            break;
+        }
+    }
+    MIX_DestroyAudioDecoder(decoder);
+
+    store(cache_path, source_hash, pcm);
+    spdlog::debug("PCMCache: decoded {} to {} KB of PCM", AssetId::toString(id), pcm.size() / 1024);
+    return MIX_LoadRawAudio(mixer, pcm.data(), pcm.size(), &spec_);
+}
+
+std::string PCMCache::getCachePath(AssetId id) const
+{
+    return (std::filesystem::path(directory_) / fmt::format("{:016x}.pcm", id.getValue())).string();
+}
+
+MIX_Audio* PCMCache::loadCached(MIX_Mixer* mixer, const std::string& cache_path, uint64_t source_hash) const
+{
+    std::ifstream file(cache_path, std::ios::binary);
+    if (!file)
+    {
+        return nullptr;
+    }
+
+    PCMHeader header;
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) || std::memcmp(header.magic, PCM_MAGIC, sizeof(PCM_MAGIC)) != 0)
+    {
+        spdlog::warn("PCMCache: {} is not a cache file, re-decoding", cache_path);
+        return nullptr;
+    }
+    if (header.source_hash != source_hash || header.format != static_cast<uint32_t>(spec_.format) || header.channels != spec_.channels || header.freq != spec_.freq)
+    {
+        spdlog::debug("PCMCache: {} is stale, re-decoding", cache_path);
+        return nullptr;
+    }
+
+    // one read straight into the buffer the mixer keeps
+    void* data = SDL_malloc(static_cast<size_t>(header.data_size));
+    if (data == nullptr || !file.read(static_cast<char*>(data), static_cast<std::streamsize>(header.data_size)))
+    {
+        spdlog::warn("PCMCache: {} is truncated, re-decoding", cache_path);
+        SDL_free(data);
+        return nullptr;
+    }
+
+    MIX_Audio* audio = MIX_LoadRawAudioNoCopy(mixer, data, static_cast<size_t>(header.data_size), &spec_, true);
+    if (audio == nullptr)
+    {
+        SDL_free(data);
+    }
+    return audio;
+}
+
+void PCMCache::store(const std::string& cache_path, uint64_t source_hash, std::span<const std::byte> pcm) const
+{
+    PCMHeader header{};
+    std::memcpy(header.magic, PCM_MAGIC, sizeof(PCM_MAGIC));
+    header.source_hash = source_hash;
+    header.format = static_cast<uint32_t>(spec_.format);
+    header.channels = spec_.channels;
+    header.freq = spec_.freq;
+    header.data_size = pcm.size();
+
+    // written aside and renamed so a crash never leaves a half written entry behind; each store gets its own temp
+    // file, workers decoding the same clip would otherwise truncate each other's
+    std::string temp_path = fmt::format("{}.{}.tmp", cache_path, store_count_.fetch_add(1, std::memory_order_relaxed));
+    {
+        std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(pcm.data()), static_cast<std::streamsize>(pcm.size()));
+        if (!file)
+        {
+            spdlog::warn("PCMCache: failed to write {}", temp_path);
+            return;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temp_path, cache_path, error);
+    if (error)
+    {
+        spdlog::warn("PCMCache: failed to store {}: {}", cache_path, error.message());
+        std::filesystem::remove(temp_path, error);
+    }
+}
+
+} // namespace engine::resource
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <span>
+#include <string>
+#include <string_view>
+
+#include <SDL3_mixer/SDL_mixer.h>
+
+#include "engine/resource/AssetId.hpp"
+
+namespace engine::resource
+{
+
+// Decoded sound effects stored on disk as raw PCM in the mixer's format, one file per asset. Each file records
+// the hash of the source bytes and the spec it was decoded to, a mismatch on either re-decodes and overwrites it.
+// Safe to use from worker threads.
+class PCMCache final
+{
+private:
+    std::string directory_;
+    SDL_AudioSpec spec_;
+    mutable std::atomic<int> hits_ = 0;
+    mutable std::atomic<int> misses_ = 0;
+    // numbers the temp files of concurrent stores
+    mutable std::atomic<uint32_t> store_count_ = 0;
+
+public:
+    PCMCache(std::string_view directory, const SDL_AudioSpec& spec);
+
+    PCMCache(const PCMCache&) = delete;
+    PCMCache& operator=(const PCMCache&) = delete;
+    PCMCache(PCMCache&&) = delete;
+    PCMCache& operator=(PCMCache&&) = delete;
+
+    // source is the encoded file; nullptr if it can't be decoded
+    MIX_Audio* load(MIX_Mixer* mixer, AssetId id, std::span<const std::byte> source) const;
+
+    int getHits() const { return hits_; }
+    int getMisses() const { return misses_; }
+
+private:
+    std::string getCachePath(AssetId id) const;
+    MIX_Audio* loadCached(MIX_Mixer* mixer, const std::string& cache_path, uint64_t source_hash) const;
+    void store(const std::string& cache_path, uint64_t source_hash, std::span<const std::byte> pcm) const;
+};
+
+} // namespace engine::resource
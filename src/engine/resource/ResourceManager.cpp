@@ -1,8 +1,17 @@
 #include "ResourceManager.hpp"
 
+#include <algorithm>
+#include <filesystem>
+#include <limits>
+
+#include <SDL3/SDL_timer.h>
 #include <glm/vec2.hpp>
 #include <spdlog/spdlog.h>
 
+#include "engine/core/Profiler.hpp"
+#include "engine/core/ThreadPool.hpp"
+
+#include "AssetArchive.hpp"
 #include "AudioManager.hpp"
 #include "FontManager.hpp"
 #include "TextureManager.hpp"
@@ -12,8 +21,9 @@ namespace engine::resource
 
 ResourceManager::ResourceManager(SDL_Renderer *renderer)
 {
-    texture_manager_ = std::make_unique<TextureManager>(renderer);
-    audio_manager_ = std::make_unique<AudioManager>();
+    thread_pool_ = std::make_unique<engine::core::ThreadPool>(engine::core::ThreadPool::getDefaultThreadCount());
+    texture_manager_ = std::make_unique<TextureManager>(renderer, thread_pool_.get());
+    audio_manager_ = std::make_unique<AudioManager>(thread_pool_.get());
     font_manager_ = std::make_unique<FontManager>();
 
     spdlog::trace("ResourceManager initialized successfully");
@@ -21,6 +31,7 @@ ResourceManager::ResourceManager(SDL_Renderer *renderer)
 
 ResourceManager::~ResourceManager()
 {
+    thread_pool_.reset();
     clear();
     spdlog::trace("ResourceManager destroyed successfully");
 }
@@ -32,24 +43,201 @@ void ResourceManager::clear()
     font_manager_->clear();
 }
 
+bool ResourceManager::openArchive(std::string_view archive_path)
+{
+    if (archive_)
+    {
+        // fonts and streamed music keep reading from the current mapping
+        spdlog::error("ResourceManager: an asset archive is already open, not opening {}", archive_path);
+        return false;
+    }
+    if (!std::filesystem::exists(std::filesystem::path(archive_path)))
+    {
+        spdlog::info("ResourceManager: no asset archive at {}, loading loose files", archive_path);
+        return false;
+    }
+
+    try
+    {
+        archive_ = std::make_unique<AssetArchive>(archive_path);
+    }
+    catch (const std::exception& e)
+    {
+        spdlog::error("ResourceManager: {}. Loading loose files", e.what());
+        return false;
+    }
+    texture_manager_->setArchive(archive_.get());
+    audio_manager_->setArchive(archive_.get());
+    font_manager_->setArchive(archive_.get());
+    return true;
+}
+
+void ResourceManager::update()
+{
+    ISLAND_PROFILE_SCOPE("ResourceManager::update");
+    texture_manager_->update(upload_budget_ns_, upload_budget_bytes_);
+}
+
+bool ResourceManager::preloadLevel(const LevelManifest& manifest)
+{
+    ISLAND_PROFILE_SCOPE("ResourceManager::preloadLevel");
+    Uint64 start = SDL_GetTicksNS();
+
+    if (current_level_.has_value())
+    {
+        for (const auto& path : current_level_->getTextures())
+        {
+            texture_manager_->release(texture_manager_->findHandle(AssetId::fromPath(path)));
+        }
+
+        size_t unloaded = 0;
+        for (const auto& path : current_level_->getTextures())
+        {
+            if (!std::binary_search(manifest.getTextures().begin(), manifest.getTextures().end(), path))
+            {
+                texture_manager_->unload(AssetId::fromPath(path));
+                ++unloaded;
+            }
+        }
+        for (const auto& path : current_level_->getSounds())
+        {
+            if (!std::binary_search(manifest.getSounds().begin(), manifest.getSounds().end(), path))
+            {
+                audio_manager_->unload(AssetId::fromPath(path));
+                ++unloaded;
+            }
+        }
+        for (const auto& font : current_level_->getFonts())
+        {
+            if (!std::binary_search(manifest.getFonts().begin(), manifest.getFonts().end(), font))
+            {
+                font_manager_->unload(AssetId::fromPath(font.path), font.size);
+                ++unloaded;
+            }
+        }
+        spdlog::info("ResourceManager: leaving {}, unloaded {} assets not used by {}", current_level_->getMapPath(), unloaded, manifest.getMapPath());
+    }
+
+    // textures decode on the pool while the sounds below do too
+    std::vector<TextureHandle> unpinned;
+    unpinned.reserve(manifest.getTextures().size());
+    for (const auto& path : manifest.getTextures())
+    {
+        unpinned.push_back(texture_manager_->loadAsync(path));
+    }
+
+    // the level's textures stay pinned until the next preloadLevel. Each one is pinned as soon as it is resident,
+    // every update() may evict unpinned textures to make room for the next upload
+    size_t textures = 0;
+    auto pin_resident = [this, &unpinned, &textures]() {
+        for (auto& handle : unpinned)
+        {
+            if (handle.isValid() && texture_manager_->resolve(handle) != nullptr)
+            {
+                texture_manager_->retain(handle);
+                handle = {};
+                ++textures;
+            }
+        }
+    };
+    pin_resident();
+
+    size_t sounds = audio_manager_->preload(manifest.getSounds());
+    size_t fonts = 0;
+    for (const auto& font : manifest.getFonts())
+    {
+        fonts += font_manager_->load(font.path, font.size) != nullptr ? 1 : 0;
+    }
+    while (texture_manager_->getPendingCount() > 0)
+    {
+        texture_manager_->update(std::numeric_limits<Uint64>::max(), std::numeric_limits<size_t>::max());
+        pin_resident();
+        if (texture_manager_->getPendingCount() > 0)
+        {
+            SDL_Delay(1);
+        }
+    }
+    current_level_ = manifest;
+
+    spdlog::info("ResourceManager: preloaded {} in {:.1f} ms: {}/{} textures, {}/{} sounds, {}/{} fonts", manifest.getMapPath(), static_cast<double>(SDL_GetTicksNS() - start) / 1'000'000.0, textures, manifest.getTextures().size(), sounds, manifest.getSounds().size(), fonts, manifest.getFonts().size());
+    return textures == manifest.getTextures().size() && sounds == manifest.getSounds().size() && fonts == manifest.getFonts().size();
+}
+
 SDL_Texture *ResourceManager::loadTexture(std::string_view file_path)
 {
+    ISLAND_PROFILE_SCOPE("ResourceManager::loadTexture");
     return texture_manager_->load(file_path);
 }
 
-SDL_Texture *ResourceManager::getTexture(std::string_view file_path)
+SDL_Texture *ResourceManager::getTexture(AssetId id)
 {
-    return texture_manager_->get(file_path);
+    return texture_manager_->get(id);
 }
 
-void ResourceManager::unloadTexture(std::string_view file_path)
+TextureRegion ResourceManager::getTextureRegion(AssetId id)
 {
-    texture_manager_->unload(file_path);
+    return texture_manager_->getRegion(id);
 }
 
-glm::vec2 ResourceManager::getTextureSize(std::string_view file_path)
+TextureHandle ResourceManager::acquireTextureHandle(std::string_view file_path)
 {
-    return texture_manager_->getSize(file_path);
+    return texture_manager_->acquireHandle(file_path);
+}
+
+const TextureRegion* ResourceManager::resolveTexture(TextureHandle handle) const
+{
+    return texture_manager_->resolve(handle);
+}
+
+TextureHandle ResourceManager::loadTextureAsync(std::string_view file_path)
+{
+    return texture_manager_->loadAsync(file_path);
+}
+
+bool ResourceManager::isTexturePending(TextureHandle handle) const
+{
+    return texture_manager_->isPending(handle);
+}
+
+int ResourceManager::getPendingTextureCount() const
+{
+    return texture_manager_->getPendingCount();
+}
+
+void ResourceManager::setTextureUploadBudget(float budget_ms, size_t budget_bytes)
+{
+    upload_budget_ns_ = static_cast<Uint64>(budget_ms * 1'000'000.0f);
+    upload_budget_bytes_ = budget_bytes;
+}
+
+void ResourceManager::retainTexture(TextureHandle handle)
+{
+    texture_manager_->retain(handle);
+}
+
+void ResourceManager::releaseTexture(TextureHandle handle)
+{
+    texture_manager_->release(handle);
+}
+
+void ResourceManager::setTextureMemoryBudget(size_t budget_bytes)
+{
+    texture_manager_->setMemoryBudget(budget_bytes);
+}
+
+const TextureMemoryStats& ResourceManager::getTextureMemoryStats() const
+{
+    return texture_manager_->getMemoryStats();
+}
+
+void ResourceManager::unloadTexture(AssetId id)
+{
+    texture_manager_->unload(id);
+}
+
+glm::vec2 ResourceManager::getTextureSize(AssetId id)
+{
+    return texture_manager_->getSize(id);
 }
 
 void ResourceManager::clearTexture()
@@ -57,50 +245,78 @@ void ResourceManager::clearTexture()
     texture_manager_->clear();
 }
 
+bool ResourceManager::buildTextureAtlas(std::string_view group, const std::vector<std::string>& file_paths, int page_size, int max_sprite_size)
+{
+    ISLAND_PROFILE_SCOPE("ResourceManager::buildTextureAtlas");
+    return texture_manager_->buildAtlas(group, file_paths, page_size, max_sprite_size);
+}
+
+void ResourceManager::unloadTextureAtlas(std::string_view group)
+{
+    texture_manager_->unloadAtlas(group);
+}
+
+AtlasStats ResourceManager::getTextureAtlasStats(std::string_view group) const
+{
+    return texture_manager_->getAtlasStats(group);
+}
+
 MIX_Audio *ResourceManager::loadSound(std::string_view file_path)
 {
+    ISLAND_PROFILE_SCOPE("ResourceManager::loadSound");
     return audio_manager_->load(file_path);
 }
-MIX_Audio *ResourceManager::getSound(std::string_view file_path)
+size_t ResourceManager::preloadSounds(const std::vector<std::string>& file_paths)
+{
+    ISLAND_PROFILE_SCOPE("ResourceManager::preloadSounds");
+    return audio_manager_->preload(file_paths);
+}
+bool ResourceManager::setSoundCacheDirectory(std::string_view directory)
+{
+    return audio_manager_->setPCMCacheDirectory(directory);
+}
+MIX_Audio *ResourceManager::getSound(AssetId id)
 {
-    return audio_manager_->get(file_path);
+    return audio_manager_->get(id);
 }
-void ResourceManager::unloadSound(std::string_view file_path)
+void ResourceManager::unloadSound(AssetId id)
 {
-    audio_manager_->unload(file_path);
+    audio_manager_->unload(id);
 }
 void ResourceManager::clearSound()
 {
-    audio_manager_->clear();
+    audio_manager_->clear(true);
 }
 MIX_Audio *ResourceManager::loadMusic(std::string_view file_path)
 {
-    return audio_manager_->load(file_path);
+    ISLAND_PROFILE_SCOPE("ResourceManager::loadMusic");
+    return audio_manager_->load(file_path, false);
 }
-MIX_Audio *ResourceManager::getMusic(std::string_view file_path)
+MIX_Audio *ResourceManager::getMusic(AssetId id)
 {
-    return audio_manager_->get(file_path);
+    return audio_manager_->get(id, false);
 }
-void ResourceManager::unloadMusic(std::string_view file_path)
+void ResourceManager::unloadMusic(AssetId id)
 {
-    audio_manager_->unload(file_path);
+    audio_manager_->unload(id, false);
 }
 void ResourceManager::clearMusic()
 {
-    audio_manager_->clear();
+    audio_manager_->clear(false);
 }
 TTF_Font *ResourceManager::loadFont(std::string_view file_path, int font_size)
 {
+    ISLAND_PROFILE_SCOPE("ResourceManager::loadFont");
     return font_manager_->load(file_path, font_size);
 }
-TTF_Font *ResourceManager::getMFont(std::string_view file_path, int font_size)
+TTF_Font *ResourceManager::getMFont(AssetId id, int font_size)
 {
-    return font_manager_->get(file_path, font_size);
+    return font_manager_->get(id, font_size);
 }
 
-void ResourceManager::unloadFont(std::string_view file_path, int font_size)
+void ResourceManager::unloadFont(AssetId id, int font_size)
 {
-    font_manager_->unload(file_path, font_size);
+    font_manager_->unload(id, font_size);
 }
 
 void ResourceManager::clearFont()
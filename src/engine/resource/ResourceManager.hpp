@@ -1,29 +1,53 @@
 #pragma once
 
+#include <cstddef>
 #include <memory>
+#include <optional>
+#include <string>
 #include <string_view>
+#include <vector>
 
 #include <SDL3/SDL_render.h>
 #include <glm/fwd.hpp>
 
+#include "engine/resource/AssetId.hpp"
+#include "engine/resource/LevelManifest.hpp"
+#include "engine/resource/TextureHandle.hpp"
+#include "engine/resource/TextureRegion.hpp"
+
 struct SDL_Renderer;
 struct SDL_Texture;
 struct MIX_Audio;
 struct TTF_Font;
 
+namespace engine::core
+{
+class ThreadPool;
+}
+
 namespace engine::resource
 {
 
 class TextureManager;
 class AudioManager;
 class FontManager;
+class AssetArchive;
 
 class ResourceManager final
 {
 private:
+    // declared first so the mapping outlives every font and streamed track reading from it
+    std::unique_ptr<AssetArchive> archive_;
     std::unique_ptr<TextureManager> texture_manager_;
     std::unique_ptr<AudioManager> audio_manager_;
     std::unique_ptr<FontManager> font_manager_;
+    // declared last so queued loads finish before the managers they report to are destroyed
+    std::unique_ptr<engine::core::ThreadPool> thread_pool_;
+
+    Uint64 upload_budget_ns_ = 2'000'000;
+    size_t upload_budget_bytes_ = 4 * 1024 * 1024;
+
+    std::optional<LevelManifest> current_level_;
 
 public:
     explicit ResourceManager(SDL_Renderer* renderer);
@@ -35,29 +59,65 @@ public:
     ResourceManager& operator=(ResourceManager&&) = delete;
 
     void clear();
-    //
+    // finishes async work on the main thread, call once per frame
+    void update();
+    engine::core::ThreadPool* getThreadPool() const { return thread_pool_.get(); }
+
+    // Maps a packed archive (tools/asset_packer) and serves the assets it holds from it from then on, assets
+    // missing from it still load from their files. Returns false and keeps using loose files if it can't be opened.
+    // Only one archive per run: loaded fonts and music stream from its mapping, a second call is refused.
+    bool openArchive(std::string_view archive_path);
+    bool hasArchive() const { return archive_ != nullptr; }
+
+    // Blocks until every asset of the level is resident, decoding in parallel. Assets of the previous level
+    // that the new one doesn't list are unloaded first, shared ones stay loaded.
+    bool preloadLevel(const LevelManifest& manifest);
+
+    // Loads take the file path and intern it; everything else takes an AssetId, built at compile time from a
+    // literal or with AssetId::fromPath at runtime. A lookup miss loads from the interned path.
     SDL_Texture* loadTexture(std::string_view file_path);
-    SDL_Texture* getTexture(std::string_view file_path);
-    void unloadTexture(std::string_view file_path);
-    glm::vec2 getTextureSize(std::string_view file_path);
+    // a standalone texture only, nullptr for an atlas-packed image; draw that through getTextureRegion
+    SDL_Texture* getTexture(AssetId id);
+    TextureRegion getTextureRegion(AssetId id);
+    TextureHandle acquireTextureHandle(std::string_view file_path);
+    const TextureRegion* resolveTexture(TextureHandle handle) const;
+    TextureHandle loadTextureAsync(std::string_view file_path);
+    bool isTexturePending(TextureHandle handle) const;
+    int getPendingTextureCount() const;
+    void setTextureUploadBudget(float budget_ms, size_t budget_bytes);
+    // retained textures are exempt from budget eviction
+    void retainTexture(TextureHandle handle);
+    void releaseTexture(TextureHandle handle);
+    // 0 disables eviction
+    void setTextureMemoryBudget(size_t budget_bytes);
+    const TextureMemoryStats& getTextureMemoryStats() const;
+    void unloadTexture(AssetId id);
+    glm::vec2 getTextureSize(AssetId id);
     void clearTexture();
 
+    bool buildTextureAtlas(std::string_view group, const std::vector<std::string>& file_paths, int page_size = 1024, int max_sprite_size = 256);
+    void unloadTextureAtlas(std::string_view group);
+    AtlasStats getTextureAtlasStats(std::string_view group) const;
+
     //
     MIX_Audio* loadSound(std::string_view file_path);
-    MIX_Audio* getSound(std::string_view file_path);
-    void unloadSound(std::string_view file_path);
+    size_t preloadSounds(const std::vector<std::string>& file_paths);
+    // decoded sound effects are cached there across runs, empty disables it
+    bool setSoundCacheDirectory(std::string_view directory);
+    MIX_Audio* getSound(AssetId id);
+    void unloadSound(AssetId id);
     void clearSound();
 
     //
     MIX_Audio* loadMusic(std::string_view file_path);
-    MIX_Audio* getMusic(std::string_view file_path);
-    void unloadMusic(std::string_view file_path);
+    MIX_Audio* getMusic(AssetId id);
+    void unloadMusic(AssetId id);
     void clearMusic();
 
     //
     TTF_Font* loadFont(std::string_view file_path, int font_size);
-    TTF_Font* getMFont(std::string_view file_path, int font_size);
-    void unloadFont(std::string_view file_path, int font_size);
+    TTF_Font* getMFont(AssetId id, int font_size);
+    void unloadFont(AssetId id, int font_size);
     void clearFont();
 };
 } // namespace engine::resource
\ No newline at end of file
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstdint>
+
+namespace engine::resource
+{
+
+// Index into TextureManager's slot table plus the generation it was issued for.
+// Unloading a texture bumps the slot generation, so older handles stop resolving instead of dangling.
+struct TextureHandle
+{
+    static constexpr uint32_t INVALID_INDEX = 0xFFFFFFFFu;
+
+    uint32_t index = INVALID_INDEX;
+    uint32_t generation = 0;
+
+    bool isValid() const { return index != INVALID_INDEX; }
+    bool operator==(const TextureHandle&) const = default;
+};
+
+} // namespace engine::resource
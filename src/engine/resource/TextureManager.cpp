@@ -1,15 +1,34 @@
 #include "TextureManager.hpp"
 
+#include <algorithm>
+#include <utility>
+
 #include <SDL3/SDL_render.h>
+#include <SDL3/SDL_surface.h>
+#include <SDL3/SDL_timer.h>
 #include <SDL3_image/SDL_image.h>
 
 #include <glm/vec2.hpp>
 #include <spdlog/spdlog.h>
 
+#include "engine/core/ThreadPool.hpp"
+#include "engine/resource/AssetArchive.hpp"
+#include "engine/resource/TexturePacker.hpp"
+
 namespace engine::resource
 {
-TextureManager::TextureManager(SDL_Renderer* renderer)
+
+void TextureManager::SDLSurfaceDeleter::operator()(SDL_Surface* surface) const
+{
+    if (surface)
+    {
+        SDL_DestroySurface(surface);
+    }
+}
+
+TextureManager::TextureManager(SDL_Renderer* renderer, engine::core::ThreadPool* thread_pool)
     : renderer_(renderer)
+    , thread_pool_(thread_pool)
 {
     if (renderer_ == nullptr)
     {
@@ -19,76 +38,695 @@ TextureManager::TextureManager(SDL_Renderer* renderer)
     spdlog::trace("TextureManager constructed successfully");
 }
 
+namespace
+{
+// Blits image into page at (x, y) and repeats its outermost pixels one pixel further out, so filtering at the
+// edge of the region samples the image itself instead of its neighbour in the page.
+bool blitExtruded(SDL_Surface* image, SDL_Surface* page, int x, int y)
+{
+    const int w = image->w;
+    const int h = image->h;
+    const SDL_Rect copies[][2] = {
+        {{0, 0, w, h}, {x, y, w, h}},
+        {{0, 0, 1, h}, {x - 1, y, 1, h}},
+        {{w - 1, 0, 1, h}, {x + w, y, 1, h}},
+        {{0, 0, w, 1}, {x, y - 1, w, 1}},
+        {{0, h - 1, w, 1}, {x, y + h, w, 1}},
+        {{0, 0, 1, 1}, {x - 1, y - 1, 1, 1}},
+        {{w - 1, 0, 1, 1}, {x + w, y - 1, 1, 1}},
+        {{0, h - 1, 1, 1}, {x - 1, y + h, 1, 1}},
+        {{w - 1, h - 1, 1, 1}, {x + w, y + h, 1, 1}},
+    };
+    SDL_SetSurfaceBlendMode(image, SDL_BLENDMODE_NONE);
+    for (const auto& copy : copies)
+    {
+        SDL_Rect dest = copy[1];
+        if (!SDL_BlitSurface(image, &copy[0], page, &dest))
+            return false;
+    }
+    return true;
+}
+} // namespace
+
 SDL_Texture* TextureManager::load(std::string_view file_path)
 {
-    std::string path(file_path);
+    AssetId id = AssetId::intern(file_path);
+    if (!id.isValid())
+    {
+        return nullptr;
+    }
 
-    if (auto it = texture_map_.find(path); it != texture_map_.end())
+    if (auto it = texture_map_.find(id); it != texture_map_.end())
     {
-        spdlog::warn("TextureManager: texture already loaded: {}", path);
-        return it->second.get();
+        spdlog::warn("TextureManager: texture already loaded: {}", file_path);
+        it->second.last_used_frame = frame_;
+        return it->second.texture.get();
+    }
+    if (atlas_map_.contains(id))
+    {
+        // a standalone copy would keep the image resident twice
+        spdlog::warn("TextureManager: {} is packed into an atlas, not loading it on its own. Draw it through getRegion instead", file_path);
+        return nullptr;
     }
 
-    SDL_Texture* texture = IMG_LoadTexture(renderer_, file_path.data());
+    std::string path(file_path);
+    SDL_Texture* texture = nullptr;
+    if (archive_ && archive_->find(id))
+    {
+        if (SurfacePtr surface = loadSurface(id, path))
+        {
+            texture = SDL_CreateTextureFromSurface(renderer_, surface.get());
+        }
+    }
+    else
+    {
+        texture = IMG_LoadTexture(renderer_, path.c_str());
+    }
     if (texture == nullptr)
     {
         spdlog::error("TextureManager: failed to load texture: {}. SDL error: {}", path, SDL_GetError());
         return nullptr;
     }
 
-    texture_map_.emplace(path, std::unique_ptr<SDL_Texture, SDLTextureDeleter>(texture));
+    addTexture(id, texture);
+    // an async load of the same path still in flight now has nothing left to upload
+    if (auto slot = slot_map_.find(id); slot != slot_map_.end() && slots_[slot->second].is_pending)
+    {
+        TextureSlot& pending = slots_[slot->second];
+        pending.is_pending = false;
+        --pending_count_;
+        bindSlot(pending, texture_map_.find(id)->second);
+    }
     spdlog::info("TextureManager: texture loaded successfully: {}", path);
     return texture;
 }
 
-SDL_Texture* TextureManager::get(std::string_view file_path)
+SDL_Texture* TextureManager::get(AssetId id)
 {
-    if (auto it = texture_map_.find(std::string(file_path)); it != texture_map_.end())
+    if (auto it = texture_map_.find(id); it != texture_map_.end())
     {
-        return it->second.get();
+        it->second.last_used_frame = frame_;
+        return it->second.texture.get();
     }
-    else
+
+    std::string path = AssetId::getPath(id);
+    if (path.empty())
+    {
+        spdlog::error("TextureManager: texture {} not found and was never loaded by path", AssetId::toString(id));
+        return nullptr;
+    }
+    if (atlas_map_.contains(id))
+    {
+        // the page holds other images too and a standalone copy would keep the image resident twice
+        spdlog::warn("TextureManager: {} is packed into an atlas and has no texture of its own. Draw it through getRegion instead", path);
+        return nullptr;
+    }
+    spdlog::warn("TextureManager: texture not found: {}. Attempting to load...", path);
+    return load(path);
+}
+
+TextureRegion TextureManager::getRegion(AssetId id)
+{
+    if (auto it = atlas_map_.find(id); it != atlas_map_.end())
+    {
+        return it->second.region;
+    }
+
+    TextureRegion region;
+    region.texture = get(id);
+    if (region.texture == nullptr)
     {
-        spdlog::warn("TextureManager: texture not found: {}. Attempting to load...", file_path);
-        return load(file_path);
+        return region;
     }
+
+    if (!SDL_GetTextureSize(region.texture, &region.rect.w, &region.rect.h))
+    {
+        spdlog::error("TextureManager: failed to query texture size: {}. SDL error: {}", AssetId::toString(id), SDL_GetError());
+        region.texture = nullptr;
+    }
+    region.texture_width = region.rect.w;
+    region.texture_height = region.rect.h;
+    return region;
 }
 
-glm::vec2 TextureManager::getSize(std::string_view file_path)
+glm::vec2 TextureManager::getSize(AssetId id)
 {
-    SDL_Texture* texture = get(file_path);
+    if (auto it = atlas_map_.find(id); it != atlas_map_.end())
+    {
+        return glm::vec2(it->second.region.rect.w, it->second.region.rect.h);
+    }
+
+    SDL_Texture* texture = get(id);
     if (texture == nullptr)
     {
-        spdlog::error("TextureManager: cannot get size, texture not loaded: {}", file_path);
+        spdlog::error("TextureManager: cannot get size, texture not loaded: {}", AssetId::toString(id));
         return glm::vec2(0.0f, 0.0f);
     }
 
     glm::vec2 size;
     if (!SDL_GetTextureSize(texture, &size.x, &size.y))
     {
-        spdlog::error("TextureManager: failed to query texture size: {}. SDL error: {}", file_path, SDL_GetError());
+        spdlog::error("TextureManager: failed to query texture size: {}. SDL error: {}", AssetId::toString(id), SDL_GetError());
         return glm::vec2(0.0f, 0.0f);
     }
     return size;
 }
 
-void TextureManager::unload(std::string_view file_path)
+void TextureManager::unload(AssetId id)
 {
-    if (auto it = texture_map_.find(std::string(file_path)); it != texture_map_.end())
+    if (auto it = atlas_map_.find(id); it != atlas_map_.end())
+    {
+        // the page stays alive until its whole group is unloaded
+        invalidateSlot(id);
+        atlas_map_.erase(it);
+        spdlog::info("TextureManager: atlas region unloaded: {}", AssetId::toString(id));
+        return;
+    }
+
+    if (texture_map_.contains(id))
+    {
+        eraseTexture(id);
+        spdlog::info("TextureManager: texture unloaded successfully: {}", AssetId::toString(id));
+    }
+    else if (auto slot = slot_map_.find(id); slot != slot_map_.end() && slots_[slot->second].is_pending)
     {
-        texture_map_.erase(it);
-        spdlog::info("TextureManager: texture unloaded successfully: {}", file_path);
+        invalidateSlot(id);
+        spdlog::info("TextureManager: pending texture load cancelled: {}", AssetId::toString(id));
     }
     else
     {
-        spdlog::warn("TextureManager: texture not found, cannot unload: {}", file_path);
+        spdlog::warn("TextureManager: texture not found, cannot unload: {}", AssetId::toString(id));
     }
 }
 
 void TextureManager::clear()
 {
+    for (auto& slot : slots_)
+    {
+        if (slot.is_live || slot.is_pending)
+        {
+            invalidateSlot(slot.id);
+        }
+    }
+    upload_queue_.clear();
+    atlas_map_.clear();
+    atlas_groups_.clear();
     texture_map_.clear();
+    memory_stats_.current_bytes = 0;
     spdlog::info("TextureManager: all textures have been unloaded");
 }
 
+bool TextureManager::buildAtlas(std::string_view group, const std::vector<std::string>& file_paths, int page_size, int max_sprite_size)
+{
+    if (page_size <= 0 || max_sprite_size <= 0)
+    {
+        spdlog::error("TextureManager: invalid atlas page size {} or max sprite size {}", page_size, max_sprite_size);
+        return false;
+    }
+
+    if (atlas_groups_.contains(std::string(group)))
+    {
+        spdlog::warn("TextureManager: atlas group {} already exists, rebuilding", group);
+        unloadAtlas(group);
+    }
+
+    struct PendingImage
+    {
+        AssetId id;
+        std::string path;
+        SurfacePtr surface;
+    };
+    std::vector<PendingImage> pending;
+
+    for (const auto& path : file_paths)
+    {
+        AssetId id = AssetId::intern(path);
+        if (!id.isValid())
+            continue;
+        if (atlas_map_.contains(id) || texture_map_.contains(id))
+        {
+            spdlog::debug("TextureManager: {} already loaded, not packing it into atlas {}", path, group);
+            continue;
+        }
+
+        SurfacePtr surface = loadSurface(id, path);
+        if (!surface)
+        {
+            spdlog::error("TextureManager: failed to load image for atlas: {}. SDL error: {}", path, SDL_GetError());
+            continue;
+        }
+
+        if (surface->w > max_sprite_size || surface->h > max_sprite_size)
+        {
+            // too big to be worth packing, upload the already decoded surface as a standalone texture
+            SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer_, surface.get());
+            if (texture == nullptr)
+            {
+                spdlog::error("TextureManager: failed to create texture: {}. SDL error: {}", path, SDL_GetError());
+                continue;
+            }
+            addTexture(id, texture);
+            continue;
+        }
+        pending.push_back({id, path, std::move(surface)});
+    }
+
+    // taller images first keeps the skyline flat
+    std::sort(pending.begin(), pending.end(), [](const PendingImage& a, const PendingImage& b) { return a.surface->h != b.surface->h ? a.surface->h > b.surface->h : a.surface->w > b.surface->w; });
+
+    TexturePacker packer(page_size, page_size, 2);
+    std::vector<SurfacePtr> page_surfaces;
+    std::vector<TexturePacker::Placement> placements;
+    placements.reserve(pending.size());
+
+    for (const auto& image : pending)
+    {
+        auto placement = packer.insert(image.surface->w, image.surface->h);
+        if (!placement.has_value())
+        {
+            spdlog::error("TextureManager: failed to pack {} into atlas {}", image.path, group);
+            placements.push_back({-1, {}});
+            continue;
+        }
+
+        while (static_cast<int>(page_surfaces.size()) <= placement->page)
+        {
+            SurfacePtr page(SDL_CreateSurface(page_size, page_size, SDL_PIXELFORMAT_RGBA32));
+            if (!page)
+            {
+                spdlog::error("TextureManager: failed to create atlas page surface. SDL error: {}", SDL_GetError());
+                return false;
+            }
+            SDL_FillSurfaceRect(page.get(), nullptr, 0);
+            page_surfaces.push_back(std::move(page));
+        }
+
+        // the packer's 2px of padding frame the image with 1px of extruded edge on every side
+        placement->rect.x += 1;
+        placement->rect.y += 1;
+        if (!blitExtruded(image.surface.get(), page_surfaces[placement->page].get(), placement->rect.x, placement->rect.y))
+        {
+            spdlog::error("TextureManager: failed to blit {} into atlas {}. SDL error: {}", image.path, group, SDL_GetError());
+            placements.push_back({-1, {}});
+            continue;
+        }
+        placements.push_back(placement.value());
+    }
+
+    AtlasGroup atlas;
+    for (const auto& page_surface : page_surfaces)
+    {
+        SDL_Texture* page = SDL_CreateTextureFromSurface(renderer_, page_surface.get());
+        if (page == nullptr)
+        {
+            spdlog::error("TextureManager: failed to create atlas page texture. SDL error: {}", SDL_GetError());
+            return false;
+        }
+        atlas.pages.emplace_back(page);
+        atlas.bytes += static_cast<size_t>(page_size) * static_cast<size_t>(page_size) * 4;
+    }
+    trackBytes(atlas.bytes, 0);
+
+    for (size_t i = 0; i < pending.size(); ++i)
+    {
+        const auto& placement = placements[i];
+        if (placement.page < 0)
+            continue;
+
+        AtlasEntry entry;
+        entry.group = std::string(group);
+        entry.region.texture = atlas.pages[placement.page].get();
+        entry.region.rect = {static_cast<float>(placement.rect.x), static_cast<float>(placement.rect.y), static_cast<float>(placement.rect.w), static_cast<float>(placement.rect.h)};
+        entry.region.texture_width = static_cast<float>(page_size);
+        entry.region.texture_height = static_cast<float>(page_size);
+        atlas_map_.emplace(pending[i].id, std::move(entry));
+        atlas.ids.push_back(pending[i].id);
+    }
+
+    atlas.stats.page_count = packer.getPageCount();
+    atlas.stats.texture_count = static_cast<int>(atlas.ids.size());
+    atlas.stats.occupancy = packer.getOccupancy();
+    spdlog::info("TextureManager: atlas {} built: {} textures in {} pages of {}x{}, occupancy {:.1f}%", group, atlas.stats.texture_count, atlas.stats.page_count, page_size, page_size, atlas.stats.occupancy * 100.0f);
+
+    atlas_groups_.emplace(std::string(group), std::move(atlas));
+    return true;
+}
+
+void TextureManager::unloadAtlas(std::string_view group)
+{
+    auto it = atlas_groups_.find(std::string(group));
+    if (it == atlas_groups_.end())
+    {
+        spdlog::warn("TextureManager: atlas group not found, cannot unload: {}", group);
+        return;
+    }
+
+    for (AssetId id : it->second.ids)
+    {
+        if (auto entry = atlas_map_.find(id); entry != atlas_map_.end() && entry->second.group == it->first)
+        {
+            invalidateSlot(id);
+            atlas_map_.erase(entry);
+        }
+    }
+    trackBytes(0, it->second.bytes);
+    atlas_groups_.erase(it);
+    spdlog::info("TextureManager: atlas group unloaded: {}", group);
+}
+
+AtlasStats TextureManager::getAtlasStats(std::string_view group) const
+{
+    if (auto it = atlas_groups_.find(std::string(group)); it != atlas_groups_.end())
+    {
+        return it->second.stats;
+    }
+    return {};
+}
+
+TextureHandle TextureManager::acquireHandle(std::string_view file_path)
+{
+    AssetId id = AssetId::intern(file_path);
+    if (!id.isValid())
+    {
+        return {};
+    }
+
+    uint32_t index = findOrCreateSlot(id, file_path);
+    if (slots_[index].is_live)
+    {
+        return {index, slots_[index].generation};
+    }
+
+    // a synchronous request overtakes a pending async load, whose upload is then dropped
+    if (slots_[index].is_pending)
+    {
+        slots_[index].is_pending = false;
+        --pending_count_;
+    }
+
+    TextureRegion region = getRegion(id);
+    if (region.texture == nullptr)
+    {
+        return {};
+    }
+
+    TextureSlot& slot = slots_[index];
+    slot.region = region;
+    slot.is_live = true;
+    slot.has_failed = false;
+    auto entry = texture_map_.find(id);
+    slot.entry = entry != texture_map_.end() ? &entry->second : nullptr;
+    return {index, slot.generation};
+}
+
+uint32_t TextureManager::findOrCreateSlot(AssetId id, std::string_view file_path)
+{
+    if (auto it = slot_map_.find(id); it != slot_map_.end())
+    {
+        return it->second;
+    }
+
+    auto index = static_cast<uint32_t>(slots_.size());
+    TextureSlot slot;
+    slot.id = id;
+    slot.path = std::string(file_path);
+    slots_.push_back(std::move(slot));
+    slot_map_.emplace(id, index);
+    return index;
+}
+
+TextureManager::SurfacePtr TextureManager::loadSurface(AssetId id, const std::string& file_path) const
+{
+    if (const ArchiveEntry* entry = archive_ ? archive_->find(id) : nullptr; entry && entry->type == ArchiveEntryType::RGBA32)
+    {
+        auto pixels = archive_->getData(*entry);
+        if (pixels.size() == static_cast<size_t>(entry->width) * entry->height * 4)
+        {
+            // the mapping is read-only, SDL only ever reads from a surface it didn't allocate
+            return SurfacePtr(SDL_CreateSurfaceFrom(static_cast<int>(entry->width), static_cast<int>(entry->height), SDL_PIXELFORMAT_RGBA32, const_cast<std::byte*>(pixels.data()), static_cast<int>(entry->width) * 4));
+        }
+        spdlog::error("TextureManager: archived image {} has a wrong payload size, decoding the loose file", file_path);
+    }
+    return SurfacePtr(IMG_Load(file_path.c_str()));
+}
+
+TextureHandle TextureManager::loadAsync(std::string_view file_path)
+{
+    AssetId id = AssetId::intern(file_path);
+    if (thread_pool_ == nullptr || !id.isValid() || atlas_map_.contains(id) || texture_map_.contains(id))
+    {
+        return acquireHandle(file_path);
+    }
+
+    uint32_t index = findOrCreateSlot(id, file_path);
+    TextureSlot& slot = slots_[index];
+    if (slot.is_live || slot.is_pending)
+    {
+        return {index, slot.generation};
+    }
+    if (slot.has_failed)
+    {
+        return {};
+    }
+
+    slot.is_pending = true;
+    ++pending_count_;
+    uint32_t generation = slot.generation;
+    thread_pool_->submit([this, id, path = slot.path, index, generation]() {
+        DecodedImage image{index, generation, loadSurface(id, path)};
+        if (!image.surface)
+        {
+            spdlog::error("TextureManager: failed to decode image: {}. SDL error: {}", path, SDL_GetError());
+        }
+        std::lock_guard lock(decoded_mutex_);
+        decoded_.push_back(std::move(image));
+    });
+    return {index, generation};
+}
+
+TextureHandle TextureManager::findHandle(AssetId id) const
+{
+    auto it = slot_map_.find(id);
+    if (it == slot_map_.end() || !slots_[it->second].is_live)
+        return {};
+    return {it->second, slots_[it->second].generation};
+}
+
+bool TextureManager::isPending(TextureHandle handle) const
+{
+    return handle.index < slots_.size() && slots_[handle.index].is_pending && slots_[handle.index].generation == handle.generation;
+}
+
+void TextureManager::update(Uint64 budget_ns, size_t budget_bytes)
+{
+    ++frame_;
+    enforceMemoryBudget();
+
+    {
+        std::lock_guard lock(decoded_mutex_);
+        for (auto& image : decoded_)
+        {
+            upload_queue_.push_back(std::move(image));
+        }
+        decoded_.clear();
+    }
+    if (upload_queue_.empty())
+        return;
+
+    Uint64 start = SDL_GetTicksNS();
+    size_t uploaded_bytes = 0;
+    bool first = true;
+    while (!upload_queue_.empty())
+    {
+        DecodedImage& image = upload_queue_.front();
+        size_t bytes = image.surface ? static_cast<size_t>(image.surface->pitch) * static_cast<size_t>(image.surface->h) : 0;
+        if (!first && (uploaded_bytes + bytes > budget_bytes || SDL_GetTicksNS() - start >= budget_ns))
+            break;
+
+        upload(image);
+        upload_queue_.pop_front();
+        uploaded_bytes += bytes;
+        first = false;
+    }
+}
+
+void TextureManager::upload(DecodedImage& image)
+{
+    TextureSlot& slot = slots_[image.slot_index];
+    if (!slot.is_pending || slot.generation != image.generation)
+    {
+        // unloaded or loaded synchronously in the meantime
+        return;
+    }
+    slot.is_pending = false;
+    --pending_count_;
+
+    if (auto existing = texture_map_.find(slot.id); existing != texture_map_.end())
+    {
+        // load() or get() brought the same path in while it was decoding
+        bindSlot(slot, existing->second);
+        return;
+    }
+    if (!image.surface)
+    {
+        slot.has_failed = true;
+        return;
+    }
+
+    SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer_, image.surface.get());
+    if (texture == nullptr)
+    {
+        spdlog::error("TextureManager: failed to create texture: {}. SDL error: {}", slot.path, SDL_GetError());
+        slot.has_failed = true;
+        return;
+    }
+
+    addTexture(slot.id, texture);
+    bindSlot(slot, texture_map_.find(slot.id)->second);
+    spdlog::debug("TextureManager: texture uploaded: {}", slot.path);
+}
+
+void TextureManager::bindSlot(TextureSlot& slot, TextureEntry& entry)
+{
+    float w = 0.0f;
+    float h = 0.0f;
+    SDL_GetTextureSize(entry.texture.get(), &w, &h);
+    slot.entry = &entry;
+    slot.region.texture = entry.texture.get();
+    slot.region.rect = {0.0f, 0.0f, w, h};
+    slot.region.texture_width = w;
+    slot.region.texture_height = h;
+    slot.is_live = true;
+    slot.has_failed = false;
+}
+
+const TextureRegion* TextureManager::resolve(TextureHandle handle) const
+{
+    if (handle.index >= slots_.size())
+        return nullptr;
+
+    const TextureSlot& slot = slots_[handle.index];
+    if (!slot.is_live || slot.generation != handle.generation)
+        return nullptr;
+    if (slot.entry)
+    {
+        slot.entry->last_used_frame = frame_;
+    }
+    return &slot.region;
+}
+
+void TextureManager::invalidateSlot(AssetId id)
+{
+    auto it = slot_map_.find(id);
+    if (it == slot_map_.end())
+        return;
+
+    TextureSlot& slot = slots_[it->second];
+    if (slot.is_pending)
+    {
+        --pending_count_;
+    }
+    if (slot.is_live || slot.is_pending)
+    {
+        ++slot.generation;
+        slot.is_live = false;
+        slot.is_pending = false;
+        slot.region = {};
+        slot.entry = nullptr;
+    }
+    slot.has_failed = false;
+}
+
+void TextureManager::retain(TextureHandle handle)
+{
+    if (handle.index < slots_.size() && slots_[handle.index].generation == handle.generation && slots_[handle.index].entry)
+    {
+        ++slots_[handle.index].entry->ref_count;
+    }
+}
+
+void TextureManager::release(TextureHandle handle)
+{
+    if (handle.index < slots_.size() && slots_[handle.index].generation == handle.generation && slots_[handle.index].entry)
+    {
+        TextureEntry* entry = slots_[handle.index].entry;
+        if (entry->ref_count > 0)
+        {
+            --entry->ref_count;
+        }
+    }
+}
+
+void TextureManager::setMemoryBudget(size_t budget_bytes)
+{
+    memory_stats_.budget_bytes = budget_bytes;
+    enforceMemoryBudget();
+}
+
+SDL_Texture* TextureManager::addTexture(AssetId id, SDL_Texture* texture)
+{
+    float w = 0.0f;
+    float h = 0.0f;
+    SDL_GetTextureSize(texture, &w, &h);
+
+    TextureEntry entry;
+    entry.texture.reset(texture);
+    entry.bytes = static_cast<size_t>(w) * static_cast<size_t>(h) * 4;
+    entry.last_used_frame = frame_;
+    trackBytes(entry.bytes, 0);
+    texture_map_.emplace(id, std::move(entry));
+
+    enforceMemoryBudget();
+    return texture;
+}
+
+void TextureManager::eraseTexture(AssetId id)
+{
+    auto it = texture_map_.find(id);
+    if (it == texture_map_.end())
+        return;
+
+    invalidateSlot(id);
+    trackBytes(0, it->second.bytes);
+    texture_map_.erase(it);
+}
+
+void TextureManager::trackBytes(size_t added, size_t removed)
+{
+    memory_stats_.current_bytes += added;
+    memory_stats_.current_bytes -= std::min(removed, memory_stats_.current_bytes);
+    memory_stats_.peak_bytes = std::max(memory_stats_.peak_bytes, memory_stats_.current_bytes);
+}
+
+void TextureManager::enforceMemoryBudget()
+{
+    if (memory_stats_.budget_bytes == 0 || memory_stats_.current_bytes <= memory_stats_.budget_bytes)
+        return;
+
+    // textures drawn this frame are still in flight, evicting them would only reload them next frame
+    std::vector<std::pair<uint64_t, AssetId>> candidates;
+    for (const auto& [id, entry] : texture_map_)
+    {
+        if (entry.ref_count == 0 && entry.last_used_frame < frame_)
+        {
+            candidates.emplace_back(entry.last_used_frame, id);
+        }
+    }
+    std::sort(candidates.begin(), candidates.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    for (const auto& [last_used, id] : candidates)
+    {
+        if (memory_stats_.current_bytes <= memory_stats_.budget_bytes)
+            break;
+        spdlog::debug("TextureManager: evicting {} (last used frame {})", AssetId::toString(id), last_used);
+        eraseTexture(id);
+        ++memory_stats_.evictions;
+    }
+
+    if (memory_stats_.current_bytes > memory_stats_.budget_bytes)
+    {
+        spdlog::warn("TextureManager: {} KB resident, over the {} KB budget with nothing left to evict", memory_stats_.current_bytes / 1024, memory_stats_.budget_bytes / 1024);
+    }
+}
+
 } // namespace engine::resource
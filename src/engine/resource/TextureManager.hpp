@@ -1,17 +1,31 @@
 #pragma once
 
+#include <deque>
 #include <memory>
-#include <unordered_map>
+#include <mutex>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
 
 #include <glm/fwd.hpp>
 #include <SDL3/SDL_render.h>
 
+#include "engine/resource/AssetId.hpp"
+#include "engine/resource/TextureHandle.hpp"
+#include "engine/resource/TextureRegion.hpp"
 #include "engine/utils/Utils.hpp"
 
+namespace engine::core
+{
+class ThreadPool;
+}
+
 namespace engine::resource
 {
 
+class AssetArchive;
+
 class TextureManager final
 {
     friend class ResourceManager;
@@ -28,11 +42,75 @@ private:
             }
         }
     };
+    // standalone texture; evictable once nothing retains it and it wasn't used this frame
+    struct TextureEntry
+    {
+        std::unique_ptr<SDL_Texture, SDLTextureDeleter> texture;
+        size_t bytes = 0;
+        int ref_count = 0;
+        uint64_t last_used_frame = 0;
+    };
+
+    struct AtlasGroup
+    {
+        std::vector<std::unique_ptr<SDL_Texture, SDLTextureDeleter>> pages;
+        size_t bytes = 0;
+        std::vector<AssetId> ids;
+        AtlasStats stats;
+    };
+
+    struct AtlasEntry
+    {
+        std::string group;
+        TextureRegion region;
+    };
+
+    // resolved view of a path for handle lookups, the slot index of a path never changes
+    struct TextureSlot
+    {
+        AssetId id;
+        std::string path;
+        TextureRegion region;
+        TextureEntry* entry = nullptr; // nullptr for atlas regions, which live as long as their group
+        uint32_t generation = 1;
+        bool is_live = false;
+        bool is_pending = false; // queued for decode or upload by loadAsync
+        bool has_failed = false;
+    };
+
+    struct SDLSurfaceDeleter
+    {
+        void operator()(SDL_Surface* surface) const;
+    };
+    using SurfacePtr = std::unique_ptr<SDL_Surface, SDLSurfaceDeleter>;
+
+    // decoded on a worker, waiting for its texture upload on the main thread
+    struct DecodedImage
+    {
+        uint32_t slot_index = 0;
+        uint32_t generation = 0;
+        SurfacePtr surface;
+    };
+
     SDL_Renderer* renderer_ = nullptr;
-    std::unordered_map<std::string, std::unique_ptr<SDL_Texture, SDLTextureDeleter>, StdStringHash> texture_map_;
+    const AssetArchive* archive_ = nullptr;
+    std::unordered_map<AssetId, TextureEntry, AssetIdHash> texture_map_;
+    std::unordered_map<std::string, AtlasGroup, StdStringHash> atlas_groups_;
+    std::unordered_map<AssetId, AtlasEntry, AssetIdHash> atlas_map_;
+    std::unordered_map<AssetId, uint32_t, AssetIdHash> slot_map_;
+    std::vector<TextureSlot> slots_;
+
+    engine::core::ThreadPool* thread_pool_ = nullptr;
+    std::mutex decoded_mutex_;
+    std::vector<DecodedImage> decoded_;
+    std::deque<DecodedImage> upload_queue_;
+    int pending_count_ = 0;
+
+    uint64_t frame_ = 0;
+    TextureMemoryStats memory_stats_;
 
 public:
-    explicit TextureManager(SDL_Renderer* renderer);
+    TextureManager(SDL_Renderer* renderer, engine::core::ThreadPool* thread_pool);
 
     TextureManager(const TextureManager&) = delete;
     TextureManager& operator=(const TextureManager&) = delete;
@@ -40,11 +118,57 @@ public:
     TextureManager& operator=(TextureManager&&) = delete;
 
 private:
+    // packed textures are uploaded straight from the archive, everything else is decoded from its file
+    void setArchive(const AssetArchive* archive) { archive_ = archive; }
+
     SDL_Texture* load(std::string_view file_path);
-    SDL_Texture* get(std::string_view file_path);
-    glm::vec2 getSize(std::string_view file_path);
-    void unload(std::string_view file_path);
+    // lookups by id never touch strings; a miss loads from the path the id was interned with. Only standalone
+    // textures: an image packed into an atlas gets nullptr and a warning, draw it through getRegion
+    SDL_Texture* get(AssetId id);
+    TextureRegion getRegion(AssetId id);
+    glm::vec2 getSize(AssetId id);
+    void unload(AssetId id);
     void clear();
+
+    // loads the texture if needed, returns an invalid handle on failure
+    TextureHandle acquireHandle(std::string_view file_path);
+    // nullptr for invalid or stale handles
+    const TextureRegion* resolve(TextureHandle handle) const;
+    // handle of an already resident texture, invalid otherwise; never loads
+    TextureHandle findHandle(AssetId id) const;
+
+    // Returns at once; the handle resolves to nullptr until a worker has decoded the image and update() uploaded it.
+    TextureHandle loadAsync(std::string_view file_path);
+    bool isPending(TextureHandle handle) const;
+    int getPendingCount() const { return pending_count_; }
+    // Once per frame: uploads decoded images until either budget is spent (at least one per call so loading
+    // always advances), then evicts down to the memory budget.
+    void update(Uint64 budget_ns, size_t budget_bytes);
+
+    // Retained textures are never evicted. Raw SDL_Texture pointers from get() are only safe for the current
+    // frame unless the texture is retained.
+    void retain(TextureHandle handle);
+    void release(TextureHandle handle);
+    void setMemoryBudget(size_t budget_bytes);
+    const TextureMemoryStats& getMemoryStats() const { return memory_stats_; }
+
+    // Packs the given images into shared pages. Images bigger than max_sprite_size, or already loaded standalone, are left out.
+    bool buildAtlas(std::string_view group, const std::vector<std::string>& file_paths, int page_size, int max_sprite_size);
+    void unloadAtlas(std::string_view group);
+    AtlasStats getAtlasStats(std::string_view group) const;
+
+private:
+    void invalidateSlot(AssetId id);
+    SDL_Texture* addTexture(AssetId id, SDL_Texture* texture);
+    void eraseTexture(AssetId id);
+    void trackBytes(size_t added, size_t removed);
+    void enforceMemoryBudget();
+    uint32_t findOrCreateSlot(AssetId id, std::string_view file_path);
+    // wraps the archived pixels without copying, or decodes the file; callable from workers
+    SurfacePtr loadSurface(AssetId id, const std::string& file_path) const;
+    void upload(DecodedImage& image);
+    // makes the slot resolve to a resident standalone texture
+    void bindSlot(TextureSlot& slot, TextureEntry& entry);
 };
 
 } // namespace engine::resource
\ No newline at end of file
@@ -0,0 +1,155 @@
+#include "TexturePacker.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <stdexcept>
+
+namespace engine::resource
+{
+
+TexturePacker::TexturePacker(int page_width, int page_height, int padding)
+    : page_width_(page_width)
+    , page_height_(page_height)
+    , padding_(padding)
+{
+    if (page_width_ <= 0 || page_height_ <= 0 || padding_ < 0)
+    {
+        throw std::runtime_error("TexturePacker construction failed: invalid page size or padding");
+    }
+}
+
+std::optional<TexturePacker::Placement> TexturePacker::insert(int width, int height)
+{
+    int padded_w = width + padding_;
+    int padded_h = height + padding_;
+    if (width <= 0 || height <= 0 || padded_w > page_width_ || padded_h > page_height_)
+    {
+        return std::nullopt;
+    }
+
+    for (size_t i = 0; i < pages_.size(); ++i)
+    {
+        size_t index = 0;
+        if (auto rect = findPosition(pages_[i], padded_w, padded_h, index); rect.has_value())
+        {
+            addSkylineLevel(pages_[i], index, rect.value());
+            pages_[i].used_area += static_cast<long long>(width) * height;
+            return Placement{static_cast<int>(i), {rect->x, rect->y, width, height}};
+        }
+    }
+
+    Page& page = pages_.emplace_back();
+    page.skyline.push_back({0, 0, page_width_});
+    size_t index = 0;
+    auto rect = findPosition(page, padded_w, padded_h, index);
+    if (!rect.has_value())
+    {
+        pages_.pop_back();
+        return std::nullopt;
+    }
+    addSkylineLevel(page, index, rect.value());
+    page.used_area += static_cast<long long>(width) * height;
+    return Placement{static_cast<int>(pages_.size()) - 1, {rect->x, rect->y, width, height}};
+}
+
+void TexturePacker::clear()
+{
+    pages_.clear();
+}
+
+float TexturePacker::getOccupancy() const
+{
+    if (pages_.empty())
+        return 0.0f;
+
+    long long used = 0;
+    for (const auto& page : pages_)
+    {
+        used += page.used_area;
+    }
+    return static_cast<float>(static_cast<double>(used) / (static_cast<double>(page_width_) * page_height_ * pages_.size()));
+}
+
+std::optional<SDL_Rect> TexturePacker::findPosition(const Page& page, int width, int height, size_t& out_index) const
+{
+    int best_bottom = INT_MAX;
+    int best_width = INT_MAX;
+    std::optional<SDL_Rect> best;
+
+    for (size_t i = 0; i < page.skyline.size(); ++i)
+    {
+        int y = fitsAt(page, i, width, height);
+        if (y < 0)
+            continue;
+
+        int bottom = y + height;
+        if (bottom < best_bottom || (bottom == best_bottom && page.skyline[i].width < best_width))
+        {
+            best_bottom = bottom;
+            best_width = page.skyline[i].width;
+            best = SDL_Rect{page.skyline[i].x, y, width, height};
+            out_index = i;
+        }
+    }
+    return best;
+}
+
+int TexturePacker::fitsAt(const Page& page, size_t index, int width, int height) const
+{
+    int x = page.skyline[index].x;
+    if (x + width > page_width_)
+        return -1;
+
+    int y = page.skyline[index].y;
+    int remaining = width;
+    for (size_t i = index; remaining > 0; ++i)
+    {
+        if (i >= page.skyline.size())
+            return -1;
+
+        y = std::max(y, page.skyline[i].y);
+        if (y + height > page_height_)
+            return -1;
+        remaining -= page.skyline[i].width;
+    }
+    return y;
+}
+
+void TexturePacker::addSkylineLevel(Page& page, size_t index, const SDL_Rect& rect)
+{
+    page.skyline.insert(page.skyline.begin() + static_cast<std::ptrdiff_t>(index), SkylineNode{rect.x, rect.y + rect.h, rect.w});
+
+    // shrink or drop the nodes now covered by the new level
+    for (size_t i = index + 1; i < page.skyline.size();)
+    {
+        SkylineNode& node = page.skyline[i];
+        const SkylineNode& prev = page.skyline[i - 1];
+        int prev_right = prev.x + prev.width;
+        if (node.x >= prev_right)
+            break;
+
+        int shrink = prev_right - node.x;
+        node.x += shrink;
+        node.width -= shrink;
+        if (node.width > 0)
+            break;
+
+        page.skyline.erase(page.skyline.begin() + static_cast<std::ptrdiff_t>(i));
+    }
+
+    // merge neighbours at the same height
+    for (size_t i = 0; i + 1 < page.skyline.size();)
+    {
+        if (page.skyline[i].y == page.skyline[i + 1].y)
+        {
+            page.skyline[i].width += page.skyline[i + 1].width;
+            page.skyline.erase(page.skyline.begin() + static_cast<std::ptrdiff_t>(i) + 1);
+        }
+        else
+        {
+            ++i;
+        }
+    }
+}
+
+} // namespace engine::resource
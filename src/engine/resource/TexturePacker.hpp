@@ -0,0 +1,57 @@
+#pragma once
+
+#include <optional>
+#include <vector>
+
+#include <SDL3/SDL_rect.h>
+
+namespace engine::resource
+{
+
+// Skyline bottom-left rectangle packer, opens a new page whenever a rect doesn't fit the existing ones.
+class TexturePacker final
+{
+public:
+    struct Placement
+    {
+        int page = 0;
+        SDL_Rect rect = {0, 0, 0, 0};
+    };
+
+private:
+    struct SkylineNode
+    {
+        int x;
+        int y;
+        int width;
+    };
+
+    struct Page
+    {
+        std::vector<SkylineNode> skyline;
+        long long used_area = 0;
+    };
+
+    int page_width_ = 0;
+    int page_height_ = 0;
+    int padding_ = 0;
+    std::vector<Page> pages_;
+
+public:
+    TexturePacker(int page_width, int page_height, int padding = 0);
+
+    std::optional<Placement> insert(int width, int height);
+    void clear();
+
+    int getPageCount() const { return static_cast<int>(pages_.size()); }
+    int getPageWidth() const { return page_width_; }
+    int getPageHeight() const { return page_height_; }
+    float getOccupancy() const;
+
+private:
+    std::optional<SDL_Rect> findPosition(const Page& page, int width, int height, size_t& out_index) const;
+    int fitsAt(const Page& page, size_t index, int width, int height) const;
+    void addSkylineLevel(Page& page, size_t index, const SDL_Rect& rect);
+};
+
+} // namespace engine::resource
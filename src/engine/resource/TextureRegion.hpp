@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <SDL3/SDL_rect.h>
+
+struct SDL_Texture;
+
+namespace engine::resource
+{
+
+// A texture as seen by draw code: either a standalone texture or a sub-rect of an atlas page.
+struct TextureRegion
+{
+    SDL_Texture* texture = nullptr;
+    SDL_FRect rect = {0.0f, 0.0f, 0.0f, 0.0f};
+    // size of the whole texture (or atlas page), needed to turn rect into UVs
+    float texture_width = 0.0f;
+    float texture_height = 0.0f;
+};
+
+struct AtlasStats
+{
+    int page_count = 0;
+    int texture_count = 0;
+    float occupancy = 0.0f;
+};
+
+struct TextureMemoryStats
+{
+    size_t current_bytes = 0; // standalone textures and atlas pages, 4 bytes per pixel
+    size_t peak_bytes = 0;
+    size_t budget_bytes = 0; // 0 = unlimited
+    uint64_t evictions = 0;
+};
+
+} // namespace engine::resource
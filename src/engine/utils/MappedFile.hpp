@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+namespace engine::utils
+{
+
+// Read-only memory mapping of a whole file. The pages stay valid until close() or destruction.
+class MappedFile final
+{
+private:
+    const std::byte* data_ = nullptr;
+    size_t size_ = 0;
+#ifdef _WIN32
+    void* file_handle_ = nullptr;
+    void* mapping_handle_ = nullptr;
+#endif
+
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&&) = delete;
+    MappedFile& operator=(MappedFile&&) = delete;
+
+    bool open(std::string_view path);
+    void close();
+
+    bool isOpen() const { return data_ != nullptr; }
+    const std::byte* getData() const { return data_; }
+    size_t getSize() const { return size_; }
+};
+
+} // namespace engine::utils
@@ -2,10 +2,12 @@
 
 #include "engine/core/GameApp.hpp"
 
-int main()
+int main(int argc, char* argv[])
 {
     spdlog::set_level(spdlog::level::trace);
     engine::core::GameApp app;
+    if (!app.parseCommandLine(argc, argv))
+        return 1;
     app.run();
     return 0;
 }
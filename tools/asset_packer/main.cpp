@@ -0,0 +1,167 @@
+// Packs the assets/ tree into one archive the engine maps at startup (see engine/resource/AssetArchive.hpp).
+// Images are stored decoded as RGBA32 so loading them is a plain upload, everything else is copied as is.
+//
+//   asset_packer <project root> <output archive>
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <SDL3/SDL.h>
+#include <SDL3_image/SDL_image.h>
+#include <spdlog/spdlog.h>
+
+#include "engine/resource/AssetArchive.hpp"
+#include "engine/resource/AssetId.hpp"
+
+namespace fs = std::filesystem;
+using engine::resource::ArchiveEntry;
+using engine::resource::ArchiveEntryType;
+using engine::resource::ArchiveHeader;
+using engine::resource::AssetId;
+
+namespace
+{
+
+bool isImage(const fs::path& path)
+{
+    std::string ext = path.extension().string();
+    std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return ext == ".png" || ext == ".jpg" || ext == ".jpeg" || ext == ".bmp";
+}
+
+void padTo(std::ofstream& out, uint64_t alignment)
+{
+    uint64_t position = static_cast<uint64_t>(out.tellp());
+    static const char zeros[engine::resource::ARCHIVE_ALIGNMENT] = {};
+    out.write(zeros, static_cast<std::streamsize>((alignment - position % alignment) % alignment));
+}
+
+// tightly packed RGBA32 rows, empty on failure
+std::vector<char> decodeImage(const fs::path& path, uint32_t& width, uint32_t& height)
+{
+    SDL_Surface* loaded = IMG_Load(path.string().c_str());
+    if (loaded == nullptr)
+    {
+        spdlog::error("asset_packer: failed to decode {}: {}", path.string(), SDL_GetError());
+        return {};
+    }
+    SDL_Surface* rgba = SDL_ConvertSurface(loaded, SDL_PIXELFORMAT_RGBA32);
+    SDL_DestroySurface(loaded);
+    if (rgba == nullptr)
+    {
+        spdlog::error("asset_packer: failed to convert {}: {}", path.string(), SDL_GetError());
+        return {};
+    }
+
+    width = static_cast<uint32_t>(rgba->w);
+    height = static_cast<uint32_t>(rgba->h);
+    size_t row_bytes = static_cast<size_t>(width) * 4;
+    std::vector<char> pixels(row_bytes * height);
+    for (uint32_t y = 0; y < height; ++y)
+    {
+        std::memcpy(pixels.data() + y * row_bytes, static_cast<const char*>(rgba->pixels) + static_cast<size_t>(y) * rgba->pitch, row_bytes);
+    }
+    SDL_DestroySurface(rgba);
+    return pixels;
+}
+
+std::vector<char> readFile(const fs::path& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    return std::vector<char>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    if (argc != 3)
+    {
+        spdlog::error("usage: asset_packer <project root> <output archive>");
+        return 1;
+    }
+    const fs::path root = argv[1];
+    const fs::path output = argv[2];
+
+    // ids hash the path relative to the root, which is what the engine's SOURCE_DIR prefixed paths reduce to
+    std::map<uint64_t, fs::path> files;
+    for (const auto& item : fs::recursive_directory_iterator(root / "assets"))
+    {
+        if (!item.is_regular_file())
+            continue;
+        std::string relative = fs::relative(item.path(), root).generic_string();
+        AssetId id = AssetId::fromPath(relative);
+        if (auto [it, inserted] = files.emplace(id.getValue(), item.path()); !inserted)
+        {
+            spdlog::error("asset_packer: hash collision between {} and {}", it->second.string(), relative);
+            return 1;
+        }
+    }
+
+    std::ofstream out(output, std::ios::binary | std::ios::trunc);
+    if (!out)
+    {
+        spdlog::error("asset_packer: cannot write {}", output.string());
+        return 1;
+    }
+
+    ArchiveHeader header{};
+    std::memcpy(header.magic, engine::resource::ARCHIVE_MAGIC, sizeof(header.magic));
+    header.version = engine::resource::ARCHIVE_VERSION;
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    // std::map keeps the table sorted by id for the reader's binary search
+    std::vector<ArchiveEntry> entries;
+    size_t images = 0;
+    for (const auto& [id, path] : files)
+    {
+        ArchiveEntry entry{};
+        entry.id = id;
+        if (!engine::resource::getArchiveSourceStamp(path, entry.source_mtime, entry.source_size))
+        {
+            spdlog::error("asset_packer: cannot stat {}", path.string());
+            continue;
+        }
+        std::vector<char> payload;
+        if (isImage(path))
+        {
+            payload = decodeImage(path, entry.width, entry.height);
+            if (payload.empty())
+                continue;
+            entry.type = ArchiveEntryType::RGBA32;
+            ++images;
+        }
+        else
+        {
+            payload = readFile(path);
+            entry.type = ArchiveEntryType::BLOB;
+        }
+
+        padTo(out, engine::resource::ARCHIVE_ALIGNMENT);
+        entry.offset = static_cast<uint64_t>(out.tellp());
+        entry.size = payload.size();
+        out.write(payload.data(), static_cast<std::streamsize>(payload.size()));
+        entries.push_back(entry);
+    }
+
+    padTo(out, engine::resource::ARCHIVE_ALIGNMENT);
+    header.toc_offset = static_cast<uint64_t>(out.tellp());
+    header.entry_count = static_cast<uint32_t>(entries.size());
+    out.write(reinterpret_cast<const char*>(entries.data()), static_cast<std::streamsize>(entries.size() * sizeof(ArchiveEntry)));
+    out.seekp(0);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    if (!out)
+    {
+        spdlog::error("asset_packer: failed while writing {}", output.string());
+        return 1;
+    }
+    spdlog::info("asset_packer: wrote {} ({} files, {} decoded images, {} KB)", output.string(), entries.size(), images, header.toc_offset / 1024);
+    return 0;
+}
@@ -0,0 +1,40 @@
+// Converts Tiled .tmj maps (and the .tsj tilesets they reference) into the engine's binary level format, see
+// engine/level/BinaryLevel.hpp. Each map is written next to its source with a .lvl extension.
+//
+//   map_converter <project root> <map.tmj>...
+
+#include <filesystem>
+
+#include <spdlog/spdlog.h>
+
+#include "engine/level/BinaryLevel.hpp"
+#include "engine/level/LevelData.hpp"
+#include "engine/level/LevelLoader.hpp"
+
+namespace fs = std::filesystem;
+
+int main(int argc, char* argv[])
+{
+    if (argc < 3)
+    {
+        spdlog::error("usage: map_converter <project root> <map.tmj>...");
+        return 1;
+    }
+
+    engine::level::LevelLoader loader(argv[1]);
+    engine::level::LevelData level;
+    int failed = 0;
+    for (int i = 2; i < argc; ++i)
+    {
+        const fs::path map_path = argv[i];
+        fs::path output = map_path;
+        output.replace_extension(".lvl");
+        if (!loader.load(map_path.string(), level) || !engine::level::writeBinaryLevel(level, output.string()))
+        {
+            ++failed;
+            continue;
+        }
+        spdlog::info("map_converter: {} -> {} ({} KB -> {} KB, {} layers, {} tiles, {} objects)", map_path.string(), output.string(), fs::file_size(map_path) / 1024, fs::file_size(output) / 1024, level.getLayers().size(), level.getTileCount(), level.getObjectCount());
+    }
+    return failed == 0 ? 0 : 1;
+}